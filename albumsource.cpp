@@ -0,0 +1,242 @@
+#include "albumsource.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QSocketNotifier>
+#include <QTimer>
+
+#include <algorithm>
+
+#include <errno.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+AlbumSource::AlbumSource(QObject *parent)
+    : QObject(parent)
+{
+    for (const QByteArray &format : QImageReader::supportedImageFormats())
+        m_suffixes.insert(QString::fromLatin1(format).toLower());
+}
+
+AlbumSource::~AlbumSource()
+{
+    stopWatch();
+}
+
+QString AlbumSource::defaultDirectory()
+{
+    const QString env = QString::fromLocal8Bit(qgetenv("SMARTDEVICE_ALBUM_DIR"));
+    if (!env.isEmpty())
+        return env;
+#ifdef ALBUM_SOURCE_DIR
+    if (!QFileInfo(ALBUM_DEFAULT_DIR).isDir() && QFileInfo(ALBUM_SOURCE_DIR).isDir())
+        return QString(ALBUM_SOURCE_DIR);
+#endif
+    return QString(ALBUM_DEFAULT_DIR);
+}
+
+bool AlbumSource::open(const QString &dir)
+{
+    close();
+
+    const QFileInfo info(dir);
+    if (!info.isDir()) {
+        qDebug() << "AlbumSource:" << dir << "is not a directory";
+        return false;
+    }
+    m_dir = QDir::cleanPath(info.absoluteFilePath());
+
+    // 先建立监视再扫描，扫描期间新增的文件不会遗漏（重复的事件在 insertFile 中忽略）
+    startWatch();
+    startScan();
+    return true;
+}
+
+void AlbumSource::close()
+{
+    stopWatch();
+    m_scan.reset();
+    m_seen.clear();
+
+    while (!m_files.isEmpty()) {
+        const QString path = m_files.takeLast();
+        emit fileRemoved(m_files.count(), path);
+    }
+    m_dir.clear();
+}
+
+bool AlbumSource::isImageFile(const QString &name) const
+{
+    const int dot = name.lastIndexOf('.');
+    return dot > 0 && !name.startsWith('.') && m_suffixes.contains(name.mid(dot + 1).toLower());
+}
+
+/**
+ * @brief 有序列表中的位置，不存在时返回 -1
+ */
+int AlbumSource::indexOf(const QString &path) const
+{
+    const auto it = std::lower_bound(m_files.constBegin(), m_files.constEnd(), path);
+    return it != m_files.constEnd() && *it == path ? int(it - m_files.constBegin()) : -1;
+}
+
+void AlbumSource::insertFile(const QString &path)
+{
+    const auto it = std::lower_bound(m_files.begin(), m_files.end(), path);
+    if (it != m_files.end() && *it == path)
+        return;
+
+    const int index = int(it - m_files.begin());
+    m_files.insert(index, path);
+    emit fileInserted(index, path);
+}
+
+void AlbumSource::removeFile(const QString &path)
+{
+    const int index = indexOf(path);
+    if (index < 0)
+        return;
+
+    m_files.removeAt(index);
+    emit fileRemoved(index, path);
+}
+
+void AlbumSource::startScan()
+{
+    m_seen.clear();
+    m_scan.reset(new QDirIterator(m_dir, QDir::Files | QDir::Readable));
+    QTimer::singleShot(0, this, &AlbumSource::scanBatch);
+}
+
+/**
+ * @brief 读取一批目录项，目录读完后移除本次扫描未见到的文件
+ */
+void AlbumSource::scanBatch()
+{
+    if (m_scan.isNull())
+        return;
+
+    for (int i = 0; i < m_scanBatchSize; ++i) {
+        if (!m_scan->hasNext()) {
+            m_scan.reset();
+
+            const QStringList files = m_files;
+            for (const QString &path : files) {
+                if (!m_seen.contains(path))
+                    removeFile(path);
+            }
+            m_seen.clear();
+
+            qDebug() << "AlbumSource:" << m_files.count() << "photos in" << m_dir;
+            emit scanFinished();
+            return;
+        }
+
+        const QString path = m_scan->next();
+        if (!isImageFile(m_scan->fileName()))
+            continue;
+        m_seen.insert(path);
+        insertFile(path);
+    }
+
+    QTimer::singleShot(0, this, &AlbumSource::scanBatch);
+}
+
+bool AlbumSource::startWatch()
+{
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0) {
+        qDebug() << "AlbumSource: inotify_init1 failed" << strerror(errno);
+        return false;
+    }
+
+    // 只关心写入完成的文件，IN_CREATE 时文件内容可能还没写完
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE |
+                          IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+    m_watch = inotify_add_watch(m_inotifyFd, QFile::encodeName(m_dir).constData(), mask);
+    if (m_watch < 0) {
+        qDebug() << "AlbumSource: inotify_add_watch failed" << m_dir << strerror(errno);
+        stopWatch();
+        return false;
+    }
+
+    m_notifier = new QSocketNotifier(m_inotifyFd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &AlbumSource::onInotifyReadable);
+    return true;
+}
+
+void AlbumSource::stopWatch()
+{
+    delete m_notifier;
+    m_notifier = nullptr;
+    if (m_inotifyFd >= 0)
+        ::close(m_inotifyFd);
+    m_inotifyFd = -1;
+    m_watch = -1;
+}
+
+void AlbumSource::onInotifyReadable()
+{
+    alignas(struct inotify_event) char buffer[4096];
+    bool rescan = false;
+    bool gone = false;
+
+    for (;;) {
+        const ssize_t n = ::read(m_inotifyFd, buffer, sizeof(buffer));
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR)
+                continue;
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < n; ) {
+            const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(buffer + offset);
+            offset += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                rescan = true;
+                continue;
+            }
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                gone = true;
+                continue;
+            }
+            if (event->len == 0 || (event->mask & IN_ISDIR))
+                continue;
+
+            const QString name = QFile::decodeName(event->name);
+            if (!isImageFile(name))
+                continue;
+            const QString path = m_dir + '/' + name;
+
+            // 扫描进行中时同步 m_seen，扫描结束时不会把这些文件当作已删除
+            if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                m_seen.remove(path);
+                removeFile(path);
+            } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                if (!m_scan.isNull())
+                    m_seen.insert(path);
+                const int index = indexOf(path);
+                if (index >= 0)
+                    emit fileChanged(index, path);
+                else
+                    insertFile(path);
+            }
+        }
+    }
+
+    if (gone) {
+        qDebug() << "AlbumSource:" << m_dir << "removed";
+        const QString dir = m_dir;
+        close();
+        m_dir = dir;
+        return;
+    }
+
+    // 事件丢失，重新扫描整个目录，只报告差异
+    if (rescan && m_scan.isNull())
+        startScan();
+}
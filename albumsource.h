@@ -0,0 +1,90 @@
+#ifndef ALBUMSOURCE_H
+#define ALBUMSOURCE_H
+
+#include <QDirIterator>
+#include <QObject>
+#include <QScopedPointer>
+#include <QSet>
+#include <QStringList>
+
+class QSocketNotifier;
+
+// 默认相册目录，由 my_qt.pro 按安装路径定义
+#ifndef ALBUM_DEFAULT_DIR
+#define ALBUM_DEFAULT_DIR "/opt/my_qt/photos"
+#endif
+// 未安装时的回退目录 ALBUM_SOURCE_DIR，由 my_qt.pro 定义为源码树中的 src/picture
+
+/**
+ * @brief 磁盘相册目录
+ *
+ * 维护目录下图片文件（按 QImageReader 支持的后缀筛选）的有序列表（按文件名排序）：
+ * - 扫描分批进行，每次事件循环只读取 scanBatchSize 个目录项，
+ *   目录很大或存储较慢时也不会阻塞GUI线程，先扫到的照片先显示
+ * - 扫描完成后用 inotify 监视目录：写入完成（IN_CLOSE_WRITE）或移入的文件加入列表，
+ *   删除或移出的文件从列表移除；事件队列溢出时重新扫描，只报告差异
+ *
+ * 列表的每次变化都通过信号按索引报告，接收方可据此增量更新而不必重新加载全部页面。
+ * 只能在GUI线程中使用。
+ */
+class AlbumSource : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AlbumSource(QObject *parent = nullptr);
+    ~AlbumSource();
+
+    /**
+     * @brief 默认目录：环境变量 SMARTDEVICE_ALBUM_DIR，其次安装目录 ALBUM_DEFAULT_DIR，
+     *        安装目录不存在（未安装的开发构建）时使用源码树中的 ALBUM_SOURCE_DIR
+     */
+    static QString defaultDirectory();
+
+    /**
+     * @brief 开始扫描并监视目录（会先清空当前列表）
+     * @return 目录不存在返回false
+     */
+    bool open(const QString &dir);
+    void close();
+
+    QString directory() const { return m_dir; }
+    QStringList files() const { return m_files; }
+    int count() const { return m_files.count(); }
+    bool isScanning() const { return !m_scan.isNull(); }
+
+    void setScanBatchSize(int size) { m_scanBatchSize = qMax(1, size); }
+
+signals:
+    void fileInserted(int index, const QString &path);   ///< 新文件插入到 index
+    void fileRemoved(int index, const QString &path);    ///< 原 index 处的文件被移除
+    void fileChanged(int index, const QString &path);    ///< 已有文件被重新写入
+    void scanFinished();                                  ///< 一次完整扫描结束
+
+private slots:
+    void scanBatch();
+    void onInotifyReadable();
+
+private:
+    bool isImageFile(const QString &name) const;
+    int indexOf(const QString &path) const;
+    void insertFile(const QString &path);
+    void removeFile(const QString &path);
+    void startScan();
+    bool startWatch();
+    void stopWatch();
+
+    QString m_dir;
+    QStringList m_files;                   ///< 完整路径，按文件名排序
+    QSet<QString> m_suffixes;              ///< 支持的后缀（小写）
+
+    QScopedPointer<QDirIterator> m_scan;   ///< 正在进行的扫描
+    QSet<QString> m_seen;                  ///< 本次扫描见到的文件，用于找出已删除的文件
+    int m_scanBatchSize = 64;
+
+    int m_inotifyFd = -1;
+    int m_watch = -1;
+    QSocketNotifier *m_notifier = nullptr;
+};
+
+#endif // ALBUMSOURCE_H
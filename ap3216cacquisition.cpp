@@ -0,0 +1,211 @@
+#include "ap3216cacquisition.h"
+#include "iiobufferreader.h"
+#include "sysfsfilecache.h"
+
+#include <QDebug>
+
+#include <errno.h>
+#include <poll.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+Ap3216cAcquisition::Ap3216cAcquisition(QObject *parent)
+    : QThread(parent),
+      m_backend(NoBackend)
+{
+    setObjectName("ap3216c-acq");
+    m_stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+}
+
+Ap3216cAcquisition::~Ap3216cAcquisition()
+{
+    stopAcquisition();
+    if (m_stopFd >= 0)
+        ::close(m_stopFd);
+}
+
+void Ap3216cAcquisition::setSysfsPaths(const QString &als, const QString &ps, const QString &ir)
+{
+    m_alsPath = als;
+    m_psPath = ps;
+    m_irPath = ir;
+}
+
+void Ap3216cAcquisition::setIntervalRange(int minMs, int maxMs)
+{
+    m_minIntervalMs = qMax(1, minMs);
+    m_maxIntervalMs = qMax(m_minIntervalMs, maxMs);
+}
+
+void Ap3216cAcquisition::startAcquisition()
+{
+    if (isRunning()) return;
+
+    // 清除上一次残留的停止请求
+    uint64_t value;
+    while (::read(m_stopFd, &value, sizeof(value)) > 0) {}
+
+    start(QThread::HighPriority);
+}
+
+void Ap3216cAcquisition::stopAcquisition()
+{
+    if (!isRunning()) return;
+
+    const uint64_t one = 1;
+    if (::write(m_stopFd, &one, sizeof(one)) < 0)
+        qDebug() << "Ap3216cAcquisition: eventfd write failed" << strerror(errno);
+    wait();
+}
+
+qint64 Ap3216cAcquisition::monotonicUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief 判断是否有值得加快采样的变化：PS 任意变化，ALS/IR 超过约 3%
+ */
+bool Ap3216cAcquisition::significantChange(const Ap3216cSample &a, const Ap3216cSample &b)
+{
+    if (a.ps != b.ps)
+        return true;
+
+    const int dAls = qAbs(static_cast<int>(a.als) - static_cast<int>(b.als));
+    const int dIr = qAbs(static_cast<int>(a.ir) - static_cast<int>(b.ir));
+    return dAls > qMax(2, b.als / 32) || dIr > qMax(2, b.ir / 32);
+}
+
+void Ap3216cAcquisition::run()
+{
+    if (!m_iioName.isEmpty()) {
+        const QString device = IioBufferReader::findDevice(m_iioName, m_iioDevicesDir);
+        if (!device.isEmpty()) {
+            IioBufferReader reader;
+            const QStringList channels = QStringList() << "in_illuminance" << "in_proximity" << "in_intensity_ir";
+            if (reader.open(device, channels, 128, m_iioDevDir)) {
+                m_backend.store(IioBuffer, std::memory_order_relaxed);
+                runIio(reader);
+                m_backend.store(NoBackend, std::memory_order_relaxed);
+                return;
+            }
+            qDebug() << "AP3216C IIO 缓冲模式不可用:" << reader.errorString();
+        }
+    }
+
+    m_backend.store(SysfsPoll, std::memory_order_relaxed);
+    runSysfs();
+    m_backend.store(NoBackend, std::memory_order_relaxed);
+}
+
+/**
+ * @brief IIO 缓冲模式：数据到达即读取，一批 scan 只发送最新一个
+ */
+void Ap3216cAcquisition::runIio(IioBufferReader &reader)
+{
+    uint8_t buf[1024];
+    struct pollfd fds[2];
+    fds[0].fd = m_stopFd;
+    fds[0].events = POLLIN;
+    fds[1].fd = reader.fd();
+    fds[1].events = POLLIN;
+
+    for (;;) {
+        int n = poll(fds, 2, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            emit acquisitionError(QString("poll 失败: %1").arg(strerror(errno)));
+            return;
+        }
+        if (fds[0].revents)
+            return;
+
+        int scans = reader.read(buf, sizeof(buf));
+        if (scans < 0) {
+            emit acquisitionError(QString("读取 IIO 缓冲区失败: %1").arg(strerror(errno)));
+            return;
+        }
+        if (scans == 0)
+            continue;
+
+        const uint8_t *scan = buf + (scans - 1) * reader.scanSize();
+        Ap3216cSample sample;
+        sample.als = static_cast<quint16>(qBound<int64_t>(0, reader.raw(scan, 0), 0xFFFF));
+        sample.ps  = static_cast<quint16>(qBound<int64_t>(0, reader.raw(scan, 1), 0xFFFF));
+        sample.ir  = static_cast<quint16>(qBound<int64_t>(0, reader.raw(scan, 2), 0xFFFF));
+        sample.timestampUs = monotonicUs();
+        emit sampleReady(sample);
+    }
+}
+
+/**
+ * @brief sysfs 后端：POLLPRI 通知 + 自适应间隔读取
+ */
+void Ap3216cAcquisition::runSysfs()
+{
+    SysfsFileCache files;
+    const int alsFile = files.add(m_alsPath, SysfsFileCache::Read);
+    const int psFile = files.add(m_psPath, SysfsFileCache::Read);
+    const int irFile = files.add(m_irPath, SysfsFileCache::Read);
+
+    Ap3216cSample last;
+    bool haveLast = false;
+    bool reportedError = false;
+    int interval = m_minIntervalMs;
+
+    for (;;) {
+        // 读取三路数据，同时重新布防 POLLPRI
+        Ap3216cSample sample;
+        sample.timestampUs = monotonicUs();
+        const bool ok = files.readUInt16(alsFile, sample.als) &&
+                        files.readUInt16(psFile, sample.ps) &&
+                        files.readUInt16(irFile, sample.ir);
+
+        if (ok) {
+            reportedError = false;
+            if (!haveLast || significantChange(sample, last))
+                interval = m_minIntervalMs;
+            else
+                interval = qMin(interval * 2, m_maxIntervalMs);
+
+            emit sampleReady(sample);
+            last = sample;
+            haveLast = true;
+        } else {
+            if (!reportedError) {
+                emit acquisitionError(QString("读取 AP3216C 失败"));
+                reportedError = true;
+            }
+            interval = m_maxIntervalMs;
+        }
+
+        // fd 打开失败时为 -1，poll() 会忽略该项
+        struct pollfd fds[4];
+        fds[0].fd = m_stopFd;
+        fds[0].events = POLLIN;
+        fds[1].fd = files.handle(alsFile);
+        fds[2].fd = files.handle(psFile);
+        fds[3].fd = files.handle(irFile);
+        for (int i = 1; i < 4; i++)
+            fds[i].events = POLLPRI;
+
+        int n;
+        do {
+            n = poll(fds, 4, interval);
+        } while (n < 0 && errno == EINTR);
+
+        if (n < 0) {
+            emit acquisitionError(QString("poll 失败: %1").arg(strerror(errno)));
+            return;
+        }
+        if (fds[0].revents)
+            return;
+
+        // 超时或收到 sysfs_notify（POLLPRI），都回到循环开头读取
+    }
+}
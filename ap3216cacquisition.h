@@ -0,0 +1,95 @@
+#ifndef AP3216CACQUISITION_H
+#define AP3216CACQUISITION_H
+
+#include <QThread>
+#include <QString>
+#include <atomic>
+
+#include "smartdevicemodule.h"
+
+class IioBufferReader;
+class SysfsFileCache;
+
+/**
+ * @brief AP3216C 采集线程
+ *
+ * 按以下顺序选择后端：
+ * 1. IIO 缓冲模式：找到同名 IIO 设备时，poll() 字符设备 /dev/iio:deviceN，数据到达即读取
+ * 2. sysfs：poll(POLLPRI) 等待驱动的 sysfs_notify，同时以自适应间隔兜底读取：
+ *    数值变化时间隔降到最小值（默认 10 ms），连续不变时逐步加倍到最大值（默认 1000 ms），
+ *    静止时每秒只唤醒一次，有变化时 10 ms 内跟上
+ *
+ * 线程中使用 poll() 阻塞，停止时通过 eventfd 唤醒，不依赖事件循环。
+ * sampleReady 在采集线程中发射，连接到其他线程的对象时自动排队。
+ * 配置接口只应在采集停止时调用。
+ */
+class Ap3216cAcquisition : public QThread
+{
+    Q_OBJECT
+
+public:
+    enum Backend {
+        NoBackend,   ///< 未运行
+        IioBuffer,   ///< IIO 缓冲模式
+        SysfsPoll    ///< sysfs 通知 + 自适应轮询
+    };
+
+    explicit Ap3216cAcquisition(QObject *parent = nullptr);
+    ~Ap3216cAcquisition();
+
+    /**
+     * @brief 设置 sysfs 属性路径
+     */
+    void setSysfsPaths(const QString &als, const QString &ps, const QString &ir);
+
+    /**
+     * @brief 设置 IIO 设备名，为空时不尝试 IIO 缓冲模式
+     */
+    void setIioDeviceName(const QString &name) { m_iioName = name; }
+
+    /**
+     * @brief 设置 IIO 设备目录与字符设备目录（默认为真实设备，测试时指向模拟目录树）
+     */
+    void setIioPaths(const QString &devicesDir, const QString &devDir)
+    {
+        m_iioDevicesDir = devicesDir;
+        m_iioDevDir = devDir;
+    }
+
+    /**
+     * @brief 设置 sysfs 后端的自适应轮询间隔范围（毫秒）
+     */
+    void setIntervalRange(int minMs, int maxMs);
+
+    void startAcquisition();    ///< 启动采集线程
+    void stopAcquisition();     ///< 唤醒并等待采集线程退出
+
+    Backend backend() const { return m_backend.load(std::memory_order_relaxed); }
+
+signals:
+    void sampleReady(const Ap3216cSample &sample);
+    void acquisitionError(const QString &errorMsg);
+
+protected:
+    void run() override;
+
+private:
+    void runIio(IioBufferReader &reader);
+    void runSysfs();
+    static qint64 monotonicUs();
+    static bool significantChange(const Ap3216cSample &a, const Ap3216cSample &b);
+
+    QString m_alsPath;
+    QString m_psPath;
+    QString m_irPath;
+    QString m_iioName = "ap3216c";
+    QString m_iioDevicesDir = "/sys/bus/iio/devices";
+    QString m_iioDevDir = "/dev";
+    int m_minIntervalMs = 10;
+    int m_maxIntervalMs = 1000;
+
+    int m_stopFd = -1;                   ///< eventfd，写入后唤醒 poll()
+    std::atomic<Backend> m_backend;
+};
+
+#endif // AP3216CACQUISITION_H
@@ -0,0 +1,241 @@
+#include "beeppatternplayer.h"
+
+#include <QDebug>
+#include <QFile>
+
+#include <errno.h>
+#include <poll.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+BeepPatternPlayer::BeepPatternPlayer(const QString &ledDir, QObject *parent)
+    : QThread(parent),
+      m_ledDir(ledDir),
+      m_mode(Idle)
+{
+    setObjectName("beep-pattern");
+
+    if (!m_ledDir.endsWith('/'))
+        m_ledDir += '/';
+
+    // pattern/repeat/delay_* 只在对应触发器生效时存在，延迟打开
+    m_triggerFile    = m_files.add(m_ledDir + "trigger");
+    m_brightnessFile = m_files.add(m_ledDir + "brightness");
+    m_patternFile    = m_files.add(m_ledDir + "pattern");
+    m_repeatFile     = m_files.add(m_ledDir + "repeat");
+    m_delayOnFile    = m_files.add(m_ledDir + "delay_on");
+    m_delayOffFile   = m_files.add(m_ledDir + "delay_off");
+
+    m_stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+}
+
+BeepPatternPlayer::~BeepPatternPlayer()
+{
+    stop();
+    if (m_stopFd >= 0)
+        ::close(m_stopFd);
+}
+
+BeepPatternPlayer::Pattern BeepPatternPlayer::beep(int onMs, int offMs)
+{
+    Pattern pattern;
+    pattern.append({ true, onMs });
+    pattern.append({ false, offMs });
+    return pattern;
+}
+
+qint64 BeepPatternPlayer::monotonicNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+bool BeepPatternPlayer::play(const Pattern &pattern, int repeat)
+{
+    stop();
+
+    if (pattern.isEmpty() || repeat <= 0)
+        return false;
+
+    qint64 cycleNs = 0;
+    for (const Step &step : pattern) {
+        if (step.durationMs < 0)
+            return false;
+        cycleNs += static_cast<qint64>(step.durationMs) * 1000000;
+    }
+    if (cycleNs == 0)
+        return false;
+
+    m_pattern = pattern;
+    m_repeat = repeat;
+    m_totalNs = cycleNs * repeat;
+
+    // 清除上一次残留的停止请求
+    uint64_t value;
+    while (::read(m_stopFd, &value, sizeof(value)) > 0) {}
+
+    start(QThread::TimeCriticalPriority);
+    return true;
+}
+
+void BeepPatternPlayer::stop()
+{
+    if (!isRunning()) return;
+
+    const uint64_t one = 1;
+    if (::write(m_stopFd, &one, sizeof(one)) < 0)
+        qDebug() << "BeepPatternPlayer: eventfd write failed" << strerror(errno);
+    wait();
+}
+
+/**
+ * @brief 触发器列表形如 "none timer [pattern] heartbeat"，当前触发器带方括号
+ */
+bool BeepPatternPlayer::hasTrigger(const char *name)
+{
+    if (m_triggers.isEmpty()) {
+        QFile file(m_ledDir + "trigger");
+        if (file.open(QIODevice::ReadOnly))
+            m_triggers = file.readAll().simplified();
+    }
+
+    const QList<QByteArray> triggers = m_triggers.split(' ');
+    for (QByteArray trigger : triggers) {
+        if (trigger.startsWith('[') && trigger.endsWith(']'))
+            trigger = trigger.mid(1, trigger.size() - 2);
+        if (trigger == name)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief pattern 触发器：每步写成 "亮度 时长 亮度 0"，时长为 0 的过渡使波形为方波
+ */
+bool BeepPatternPlayer::setupKernelPattern()
+{
+    QByteArray text;
+    for (const Step &step : m_pattern) {
+        const char *level = step.on ? "1" : "0";
+        text += level;
+        text += ' ';
+        text += QByteArray::number(step.durationMs);
+        text += ' ';
+        text += level;
+        text += " 0 ";
+    }
+    text.chop(1);
+
+    // repeat 必须在 pattern 之前写入，写入 pattern 时开始播放
+    return m_files.write(m_triggerFile, "pattern", 7) &&
+           m_files.write(m_repeatFile, QByteArray::number(m_repeat)) &&
+           m_files.write(m_patternFile, text);
+}
+
+/**
+ * @brief timer 触发器：只适用于“开-关”两步的节奏，写入触发器后立即从“开”开始闪烁
+ */
+bool BeepPatternPlayer::setupKernelTimer()
+{
+    if (m_pattern.size() != 2 || !m_pattern.at(0).on || m_pattern.at(1).on)
+        return false;
+
+    return m_files.write(m_triggerFile, "timer", 5) &&
+           m_files.write(m_delayOnFile, QByteArray::number(m_pattern.at(0).durationMs)) &&
+           m_files.write(m_delayOffFile, QByteArray::number(m_pattern.at(1).durationMs));
+}
+
+/**
+ * @brief 等待到绝对时间 deadlineNs（CLOCK_MONOTONIC）
+ * @return 被停止请求唤醒返回false
+ */
+bool BeepPatternPlayer::sleepUntil(int timerFd, qint64 deadlineNs)
+{
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec = deadlineNs / 1000000000;
+    spec.it_value.tv_nsec = deadlineNs % 1000000000;
+    if (timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) != 0)
+        return false;
+
+    struct pollfd fds[2];
+    fds[0].fd = m_stopFd;
+    fds[0].events = POLLIN;
+    fds[1].fd = timerFd;
+    fds[1].events = POLLIN;
+
+    for (;;) {
+        int n = poll(fds, 2, -1);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 || fds[0].revents)
+            return false;
+        if (fds[1].revents) {
+            uint64_t expirations;
+            if (::read(timerFd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN)
+                return false;
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief 恢复为手动控制并关闭蜂鸣器，关闭触发器专属属性的 fd
+ */
+void BeepPatternPlayer::restore()
+{
+    m_files.write(m_triggerFile, "none", 4);
+    m_files.write(m_brightnessFile, "0", 1);
+    m_files.closeAll();
+}
+
+void BeepPatternPlayer::run()
+{
+    const int timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (timerFd < 0) {
+        qDebug() << "BeepPatternPlayer: timerfd_create failed" << strerror(errno);
+        return;
+    }
+
+    const qint64 startNs = monotonicNs();
+    bool completed = false;
+
+    if (m_kernelTriggers && hasTrigger("pattern") && setupKernelPattern()) {
+        m_mode.store(KernelPattern, std::memory_order_relaxed);
+        completed = sleepUntil(timerFd, startNs + m_totalNs);
+    } else if (m_kernelTriggers && hasTrigger("timer") && setupKernelTimer()) {
+        // 在最后一个“关”的中间恢复触发器，避开边沿
+        m_mode.store(KernelTimer, std::memory_order_relaxed);
+        const qint64 halfOffNs = static_cast<qint64>(m_pattern.at(1).durationMs) * 500000;
+        completed = sleepUntil(timerFd, startNs + m_totalNs - halfOffNs);
+    } else {
+        m_mode.store(Software, std::memory_order_relaxed);
+        m_files.write(m_triggerFile, "none", 4);
+
+        // 截止时间从起点累加，单次唤醒延迟不会传递到后续步骤
+        qint64 deadlineNs = startNs;
+        completed = true;
+        for (int r = 0; r < m_repeat && completed; ++r) {
+            for (const Step &step : m_pattern) {
+                m_files.write(m_brightnessFile, step.on ? "1" : "0", 1);
+                deadlineNs += static_cast<qint64>(step.durationMs) * 1000000;
+                if (!sleepUntil(timerFd, deadlineNs)) {
+                    completed = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    restore();
+    ::close(timerFd);
+    m_mode.store(Idle, std::memory_order_relaxed);
+
+    if (completed)
+        emit finished();
+}
@@ -0,0 +1,107 @@
+#ifndef BEEPPATTERNPLAYER_H
+#define BEEPPATTERNPLAYER_H
+
+#include <QThread>
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+#include "sysfsfilecache.h"
+
+/**
+ * @brief 蜂鸣器（LED 子系统设备）节奏播放
+ *
+ * 节奏由若干 (开/关, 持续时间) 步骤组成，按以下顺序选择实现：
+ * 1. pattern 触发器：整个节奏写入 pattern/repeat 属性，由内核定时器驱动
+ * 2. timer 触发器：节奏为等宽的“开-关”时写入 delay_on/delay_off，由内核闪烁，
+ *    到达总时长时由播放线程恢复触发器
+ * 3. 软件：播放线程按绝对截止时间（CLOCK_MONOTONIC）切换 brightness，
+ *    每一步的截止时间都从起点累加，不会因某次唤醒延迟而累积误差
+ *
+ * 三种方式的节拍都不经过GUI线程，界面繁忙时节奏不受影响。
+ * 播放线程使用 poll() 等待绝对时间的 timerfd，停止时通过 eventfd 立即唤醒。
+ * play()/stop() 只应在同一个线程（通常是GUI线程）中调用。
+ */
+class BeepPatternPlayer : public QThread
+{
+    Q_OBJECT
+
+public:
+    struct Step {
+        bool on;
+        int durationMs;
+    };
+    typedef QVector<Step> Pattern;
+
+    enum Mode {
+        Idle,            ///< 未播放
+        KernelPattern,   ///< pattern 触发器
+        KernelTimer,     ///< timer 触发器
+        Software         ///< 播放线程切换 brightness
+    };
+
+    /**
+     * @param ledDir LED 设备目录，如 "/sys/class/leds/beep/"
+     */
+    explicit BeepPatternPlayer(const QString &ledDir, QObject *parent = nullptr);
+    ~BeepPatternPlayer();
+
+    /**
+     * @brief 一次“响-停”
+     */
+    static Pattern beep(int onMs, int offMs);
+
+    /**
+     * @brief 播放节奏（会先停止正在播放的节奏）
+     * @param repeat 重复次数
+     * @return 节奏为空或参数非法返回false
+     */
+    bool play(const Pattern &pattern, int repeat = 1);
+
+    /**
+     * @brief 立即停止并关闭蜂鸣器（不发射 finished）
+     */
+    void stop();
+
+    /**
+     * @brief 是否允许使用内核触发器（关闭后总是使用软件方式）
+     */
+    void setKernelTriggersEnabled(bool enabled) { m_kernelTriggers = enabled; }
+
+    Mode mode() const { return m_mode.load(std::memory_order_relaxed); }
+
+signals:
+    void finished();   ///< 节奏正常播放完毕（在播放线程中发射）
+
+protected:
+    void run() override;
+
+private:
+    bool hasTrigger(const char *name);
+    bool setupKernelPattern();
+    bool setupKernelTimer();
+    bool sleepUntil(int timerFd, qint64 deadlineNs);
+    void restore();
+    static qint64 monotonicNs();
+
+    QString m_ledDir;
+    SysfsFileCache m_files;
+    int m_triggerFile;
+    int m_brightnessFile;
+    int m_patternFile;
+    int m_repeatFile;
+    int m_delayOnFile;
+    int m_delayOffFile;
+
+    QByteArray m_triggers;       ///< 可用触发器列表（首次播放时读取）
+    bool m_kernelTriggers = true;
+
+    Pattern m_pattern;
+    int m_repeat = 1;
+    qint64 m_totalNs = 0;        ///< 节奏总时长
+
+    int m_stopFd = -1;           ///< eventfd，写入后唤醒播放线程
+    std::atomic<Mode> m_mode;
+};
+
+#endif // BEEPPATTERNPLAYER_H
@@ -0,0 +1,16 @@
+# CRC16/Modbus 三种实现的性能对比
+# 构建: qmake && make && ./crc16_bench
+
+TEMPLATE = app
+TARGET = crc16_bench
+CONFIG += console c++14
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../crc16.cpp
+
+HEADERS += \
+    ../../crc16.h
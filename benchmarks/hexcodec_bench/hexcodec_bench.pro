@@ -0,0 +1,16 @@
+# 十六进制编解码性能测试
+# 构建: qmake && make && ./hexcodec_bench
+
+TEMPLATE = app
+TARGET = hexcodec_bench
+CONFIG += console c++14
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../hexcodec.cpp
+
+HEADERS += \
+    ../../hexcodec.h
@@ -0,0 +1,165 @@
+/*
+ * 十六进制编解码微基准
+ * 对比逐字节格式化（snprintf / strtol，接近原先逐字节处理的开销）与查表实现，
+ * 分别在 16 B（控制帧）、256 B、64 KiB（大段粘贴/高速接收）上测量吞吐量
+ */
+#include "hexcodec.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static volatile size_t g_sink; // 防止编译器优化掉计算
+
+/* ================= 参考实现 ================= */
+static size_t naiveEncode(const uint8_t *src, size_t len, char *dst, char separator)
+{
+    char *out = dst;
+    for (size_t i = 0; i < len; i++) {
+        snprintf(out, 3, "%02X", src[i]);
+        out += 2;
+        if (separator && i + 1 < len)
+            *out++ = separator;
+    }
+    return static_cast<size_t>(out - dst);
+}
+
+static bool naiveDecode(const char *src, size_t len, uint8_t *dst, size_t *outLen)
+{
+    // 先去掉空白，再每两个字符转换一次
+    std::vector<char> clean;
+    for (size_t i = 0; i < len; i++) {
+        if (src[i] != ' ' && src[i] != '\t' && src[i] != '\r' && src[i] != '\n')
+            clean.push_back(src[i]);
+    }
+    if (clean.size() % 2 != 0)
+        return false;
+
+    for (size_t i = 0; i < clean.size(); i += 2) {
+        char pair[3] = { clean[i], clean[i + 1], 0 };
+        char *end;
+        long v = strtol(pair, &end, 16);
+        if (end != pair + 2)
+            return false;
+        dst[i / 2] = static_cast<uint8_t>(v);
+    }
+    *outLen = clean.size() / 2;
+    return true;
+}
+
+typedef size_t (*EncodeFunc)(const uint8_t *, size_t, char *, char);
+typedef bool (*DecodeFunc)(const char *, size_t, uint8_t *, size_t *);
+
+static bool decodeLatin1(const char *src, size_t len, uint8_t *dst, size_t *outLen)
+{
+    return hex_decode(src, len, dst, outLen);
+}
+
+static size_t iterationsFor(size_t bytes)
+{
+    // 每轮处理约 16 MiB 数据，保证计时精度
+    return (16u << 20) / bytes;
+}
+
+/**
+ * @brief 编码吞吐量（按输入字节计，MB/s）
+ */
+static double measureEncode(EncodeFunc func, const std::vector<uint8_t> &src, std::vector<char> &dst)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const size_t iterations = iterationsFor(src.size());
+    size_t acc = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; i++)
+        acc += func(src.data(), src.size(), dst.data(), ' ');
+    auto end = Clock::now();
+    g_sink = acc;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(iterations * src.size()) / seconds / 1e6;
+}
+
+/**
+ * @brief 解码吞吐量（按输入文本字节计，MB/s）
+ */
+static double measureDecode(DecodeFunc func, const std::vector<char> &src, std::vector<uint8_t> &dst)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const size_t iterations = iterationsFor(src.size());
+    size_t acc = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        size_t n = 0;
+        func(src.data(), src.size(), dst.data(), &n);
+        acc += n;
+    }
+    auto end = Clock::now();
+    g_sink = acc;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(iterations * src.size()) / seconds / 1e6;
+}
+
+int main()
+{
+    const struct { const char *name; EncodeFunc func; } encoders[] = {
+        { "snprintf", naiveEncode       },
+        { "table",    hex_encode_scalar },
+        { "encode",   hex_encode        }, // NEON 平台上为 NEON 实现
+    };
+    const struct { const char *name; DecodeFunc func; } decoders[] = {
+        { "strtol",   naiveDecode  },
+        { "table",    decodeLatin1 },
+    };
+    const size_t sizes[] = { 16, 256, 64 * 1024 };
+
+    printf("%-16s %12s %12s %12s\n", "impl", "16 B", "256 B", "64 KiB");
+
+    for (const auto &enc : encoders) {
+        printf("encode/%-9s", enc.name);
+        for (size_t size : sizes) {
+            std::vector<uint8_t> src(size);
+            for (size_t i = 0; i < size; i++)
+                src[i] = static_cast<uint8_t>(rand());
+
+            std::vector<char> expect(size * 3), out(size * 3);
+            size_t n1 = naiveEncode(src.data(), size, expect.data(), ' ');
+            size_t n2 = enc.func(src.data(), size, out.data(), ' ');
+            if (n1 != n2 || memcmp(expect.data(), out.data(), n1) != 0) {
+                printf("\n%s: 编码结果与参考实现不一致\n", enc.name);
+                return 1;
+            }
+
+            printf(" %9.1f MB/s", measureEncode(enc.func, src, out));
+        }
+        printf("\n");
+    }
+
+    for (const auto &dec : decoders) {
+        printf("decode/%-9s", dec.name);
+        for (size_t size : sizes) {
+            std::vector<uint8_t> bytes(size);
+            for (size_t i = 0; i < size; i++)
+                bytes[i] = static_cast<uint8_t>(rand());
+
+            std::vector<char> text(hex_encoded_size(size, ' '));
+            hex_encode_scalar(bytes.data(), size, text.data(), ' ');
+
+            std::vector<uint8_t> out(size);
+            size_t n = 0;
+            if (!dec.func(text.data(), text.size(), out.data(), &n) || n != size ||
+                memcmp(out.data(), bytes.data(), size) != 0) {
+                printf("\n%s: 解码结果与原始数据不一致\n", dec.name);
+                return 1;
+            }
+
+            printf(" %9.1f MB/s", measureDecode(dec.func, text, out));
+        }
+        printf("\n");
+    }
+    return 0;
+}
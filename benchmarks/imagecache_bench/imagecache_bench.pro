@@ -0,0 +1,19 @@
+# 相册图片缓存性能测试
+# 构建: qmake && make && ./imagecache_bench [图片 ...]
+
+TEMPLATE = app
+TARGET = imagecache_bench
+QT = core gui
+CONFIG += console c++14
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../imagecache.cpp \
+    ../../imagedecodeservice.cpp
+
+HEADERS += \
+    ../../imagecache.h \
+    ../../imagedecodeservice.h
@@ -0,0 +1,134 @@
+/*
+ * 相册图片缓存基准
+ *
+ * 对每张图片（不指定时生成一张 2048x1536 的 PNG）比较缩放到屏幕尺寸的三种方式：
+ *   decode : QImageReader 解码 + 缩放 + 格式转换（首次启动的路径）
+ *   store  : 写入缓存文件
+ *   load   : 映射缓存文件并读遍所有像素（再次启动的路径，含缺页）
+ *
+ * --size WxH 指定目标尺寸（默认 1024x600），--cache <目录> 指定缓存目录（默认临时目录）。
+ */
+#include "imagecache.h"
+#include "imagedecodeservice.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include <cstdio>
+
+static volatile quint32 g_sink; // 防止编译器优化掉像素访问
+
+static double elapsedMs(const QElapsedTimer &timer)
+{
+    return timer.nsecsElapsed() / 1e6;
+}
+
+/**
+ * @brief 读遍所有像素，计入映射文件的缺页开销
+ */
+static void touchPixels(const QImage &image)
+{
+    quint32 sum = 0;
+    for (int y = 0; y < image.height(); y++) {
+        const quint32 *line = reinterpret_cast<const quint32 *>(image.constScanLine(y));
+        for (int x = 0; x < image.width(); x += 16)
+            sum += line[x];
+    }
+    g_sink = sum;
+}
+
+static QString createSampleImage(const QString &dir)
+{
+    QImage image(2048, 1536, QImage::Format_RGB32);
+    for (int y = 0; y < image.height(); y++) {
+        quint32 *line = reinterpret_cast<quint32 *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); x++)
+            line[x] = qRgb(x * 255 / image.width(), y * 255 / image.height(), (x ^ y) & 0xff);
+    }
+
+    const QString path = dir + "/sample.png";
+    return image.save(path) ? path : QString();
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QSize targetSize(1024, 600);
+    QString cacheDir;
+    QStringList files;
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); i++) {
+        if (args.at(i) == "--size" && i + 1 < args.size()) {
+            const QStringList parts = args.at(++i).split('x');
+            if (parts.size() == 2)
+                targetSize = QSize(parts.at(0).toInt(), parts.at(1).toInt());
+        } else if (args.at(i) == "--cache" && i + 1 < args.size()) {
+            cacheDir = args.at(++i);
+        } else {
+            files << args.at(i);
+        }
+    }
+
+    QTemporaryDir tempDir;
+    if (cacheDir.isEmpty())
+        cacheDir = tempDir.path() + "/cache";
+    if (files.isEmpty()) {
+        const QString sample = createSampleImage(tempDir.path());
+        if (sample.isEmpty()) {
+            printf("无法生成测试图片\n");
+            return 1;
+        }
+        files << sample;
+    }
+
+    const ImageCache cache(cacheDir);
+    if (!cache.isValid()) {
+        printf("无法创建缓存目录 %s\n", qPrintable(cacheDir));
+        return 1;
+    }
+
+    printf("target %dx%d, cache %s\n\n", targetSize.width(), targetSize.height(), qPrintable(cacheDir));
+    printf("%-32s %12s %10s %10s %10s\n", "file", "output", "decode", "store", "load");
+
+    double totalDecode = 0, totalLoad = 0;
+    for (const QString &file : files) {
+        QElapsedTimer timer;
+        timer.start();
+        const QImage decoded = ImageDecodeService::decode(file, targetSize);
+        touchPixels(decoded);
+        const double decodeMs = elapsedMs(timer);
+        if (decoded.isNull()) {
+            printf("%-32s 解码失败\n", qPrintable(QFileInfo(file).fileName()));
+            continue;
+        }
+
+        const QByteArray key = ImageCache::key(file, targetSize);
+        timer.restart();
+        const bool stored = cache.store(key, decoded);
+        const double storeMs = elapsedMs(timer);
+
+        timer.restart();
+        const QImage loaded = cache.load(key);
+        touchPixels(loaded);
+        const double loadMs = elapsedMs(timer);
+
+        if (!stored || loaded.isNull() || loaded != decoded) {
+            printf("%-32s 缓存内容不一致\n", qPrintable(QFileInfo(file).fileName()));
+            return 1;
+        }
+
+        printf("%-32s %5dx%-6d %8.2f ms %7.2f ms %7.2f ms\n", qPrintable(QFileInfo(file).fileName()),
+               decoded.width(), decoded.height(), decodeMs, storeMs, loadMs);
+        totalDecode += decodeMs;
+        totalLoad += loadMs;
+    }
+
+    if (totalLoad > 0)
+        printf("\nload is %.1fx faster than decode\n", totalDecode / totalLoad);
+    return 0;
+}
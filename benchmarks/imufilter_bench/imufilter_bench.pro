@@ -0,0 +1,16 @@
+# 六轴滤波级性能测试
+# 构建: qmake && make && ./imufilter_bench [trace.bin]
+
+TEMPLATE = app
+TARGET = imufilter_bench
+CONFIG += console c++14
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../imufilter.cpp
+
+HEADERS += \
+    ../../imufilter.h
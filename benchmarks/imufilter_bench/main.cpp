@@ -0,0 +1,183 @@
+/*
+ * 六轴滤波级微基准
+ * 输入为录制的六轴数据（与 ImuAcquisition 模拟数据源格式相同：每条 6 个小端 float32，
+ * ax ay az 单位 g，gx gy gz 单位 °/s）；不指定文件时生成 60 s @ 1 kHz 的合成数据，
+ * 可用 --write <文件> 保存下来作为 ImuAcquisition 的模拟数据源。
+ *
+ * 对比：
+ *   per-sample : 每个样本单独调用一次滤波（相当于逐样本信号槽处理）
+ *   scalar     : 按批处理，逐样本参考实现
+ *   neon       : 按批处理，NEON 实现（仅 NEON 平台）
+ */
+#include "imufilter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static volatile float g_sink; // 防止编译器优化掉计算
+
+struct Trace {
+    std::vector<float> axis[IMU_AXES];
+    size_t size = 0;
+};
+
+static bool loadTrace(const char *path, Trace &trace)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        return false;
+
+    float record[IMU_AXES];
+    while (fread(record, sizeof(record), 1, fp) == 1) {
+        for (int c = 0; c < IMU_AXES; c++)
+            trace.axis[c].push_back(record[c]);
+        trace.size++;
+    }
+    fclose(fp);
+    return trace.size > 0;
+}
+
+/**
+ * @brief 合成数据：缓慢摆动的姿态 + 传感器噪声 + 陀螺仪零偏
+ */
+static void synthesizeTrace(size_t count, float rateHz, Trace &trace)
+{
+    const float dt = 1.0f / rateHz;
+    for (int c = 0; c < IMU_AXES; c++)
+        trace.axis[c].resize(count);
+
+    for (size_t i = 0; i < count; i++) {
+        const float t = i * dt;
+        const float roll = 0.5f * std::sin(2 * 3.14159265f * 0.2f * t);    // 弧度
+        const float pitch = 0.3f * std::sin(2 * 3.14159265f * 0.13f * t);
+        const float noise = 0.02f;
+
+        trace.axis[IMU_AX][i] = -std::sin(pitch) + noise * (rand() / (float)RAND_MAX - 0.5f);
+        trace.axis[IMU_AY][i] = std::cos(pitch) * std::sin(roll) + noise * (rand() / (float)RAND_MAX - 0.5f);
+        trace.axis[IMU_AZ][i] = std::cos(pitch) * std::cos(roll) + noise * (rand() / (float)RAND_MAX - 0.5f);
+        trace.axis[IMU_GX][i] = 57.3f * 0.5f * 2 * 3.14159265f * 0.2f * std::cos(2 * 3.14159265f * 0.2f * t) + 1.5f
+                                + 2.0f * (rand() / (float)RAND_MAX - 0.5f);
+        trace.axis[IMU_GY][i] = 57.3f * 0.3f * 2 * 3.14159265f * 0.13f * std::cos(2 * 3.14159265f * 0.13f * t) - 0.8f
+                                + 2.0f * (rand() / (float)RAND_MAX - 0.5f);
+        trace.axis[IMU_GZ][i] = 2.0f * (rand() / (float)RAND_MAX - 0.5f);
+    }
+    trace.size = count;
+}
+
+static bool writeTrace(const char *path, const Trace &trace)
+{
+    FILE *fp = fopen(path, "wb");
+    if (!fp)
+        return false;
+
+    for (size_t i = 0; i < trace.size; i++) {
+        float record[IMU_AXES];
+        for (int c = 0; c < IMU_AXES; c++)
+            record[c] = trace.axis[c][i];
+        fwrite(record, sizeof(record), 1, fp);
+    }
+    return fclose(fp) == 0;
+}
+
+/**
+ * @brief 按 batchSize 分批处理整段数据
+ * @param roll/pitch 输出每个样本的姿态，用于比较
+ * @return 吞吐量（百万样本/秒）
+ */
+static double run(const Trace &trace, size_t batchSize, bool useNeon, float rateHz,
+                  std::vector<float> &roll, std::vector<float> &pitch)
+{
+    using Clock = std::chrono::steady_clock;
+
+    ImuFilter::Config config;
+    config.sampleRateHz = rateHz;
+    ImuFilter filter;
+    filter.configure(config);
+    filter.setUseNeon(useNeon);
+
+    roll.resize(trace.size);
+    pitch.resize(trace.size);
+
+    ImuSoaBatch batch;
+    batch.resize(batchSize);
+
+    double seconds = 0;
+    for (size_t offset = 0; offset < trace.size; offset += batchSize) {
+        const size_t n = std::min(batchSize, trace.size - offset);
+        batch.resize(n);
+        for (int c = 0; c < IMU_AXES; c++)
+            memcpy(batch.axis[c].data(), trace.axis[c].data() + offset, n * sizeof(float));
+
+        // 只计滤波本身，拷贝输入输出不计时
+        auto start = Clock::now();
+        filter.process(batch);
+        seconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        memcpy(roll.data() + offset, batch.roll.data(), n * sizeof(float));
+        memcpy(pitch.data() + offset, batch.pitch.data(), n * sizeof(float));
+    }
+
+    g_sink = roll.back() + pitch.back();
+    return trace.size / seconds / 1e6;
+}
+
+static float maxDiff(const std::vector<float> &a, const std::vector<float> &b)
+{
+    float diff = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        diff = std::max(diff, std::fabs(a[i] - b[i]));
+    return diff;
+}
+
+int main(int argc, char **argv)
+{
+    const float rateHz = 1000.0f;
+    Trace trace;
+
+    if (argc >= 3 && strcmp(argv[1], "--write") == 0) {
+        synthesizeTrace(static_cast<size_t>(60 * rateHz), rateHz, trace);
+        if (!writeTrace(argv[2], trace)) {
+            printf("无法写入 %s\n", argv[2]);
+            return 1;
+        }
+        printf("已写入 %zu 个样本到 %s\n", trace.size, argv[2]);
+        return 0;
+    }
+
+    if (argc >= 2) {
+        if (!loadTrace(argv[1], trace)) {
+            printf("无法读取 %s\n", argv[1]);
+            return 1;
+        }
+        printf("数据: %s，%zu 个样本\n", argv[1], trace.size);
+    } else {
+        synthesizeTrace(static_cast<size_t>(60 * rateHz), rateHz, trace);
+        printf("数据: 合成 %zu 个样本 @ %.0f Hz\n", trace.size, rateHz);
+    }
+
+    std::vector<float> refRoll, refPitch, roll, pitch;
+    run(trace, 20, false, rateHz, refRoll, refPitch);
+
+    const struct { const char *name; size_t batch; bool neon; } cases[] = {
+        { "per-sample", 1,    false },
+        { "scalar/20",  20,   false },
+        { "scalar/1000", 1000, false },
+        { "neon/20",    20,   true  },
+        { "neon/1000",  1000, true  },
+    };
+
+    printf("%-14s %14s %16s\n", "impl", "Msample/s", "max diff (deg)");
+    for (const auto &c : cases) {
+        if (c.neon && !ImuFilter::neonAvailable())
+            continue;
+        const double rate = run(trace, c.batch, c.neon, rateHz, roll, pitch);
+        const float diff = std::max(maxDiff(roll, refRoll), maxDiff(pitch, refPitch));
+        printf("%-14s %14.2f %16.6f\n", c.name, rate, diff);
+    }
+    return 0;
+}
@@ -0,0 +1,300 @@
+/*
+ * smartDeviceModule 外设 I/O 基准
+ *
+ * 在 tmpfs 中建立模拟的 sysfs 目录树（LED、BEEP、ALARM、AP3216C、六轴 IIO 设备），
+ * 通过 SMARTDEVICE_SYSFS_ROOT 让 smartDeviceModule 指向它，测量：
+ *   - LED 开关次数/秒，以及每次操作的 open/write/close 次数（对比每次打开文件的写法）
+ *   - AP3216C 读取路径的样本/秒与每个样本的系统调用次数
+ *   - 采集线程实际送达的样本/秒（AP3216C 自适应轮询、六轴 1 kHz）
+ *   - 闹钟节奏的实际时长与理论时长之差
+ *   - 六轴模拟数据源回放：经 SMARTDEVICE_FAKE_IMU 走采集线程，逐条核对送达的样本
+ *
+ * --create-only 只建立目录树并打印路径，可用于在开发机上运行整个程序：
+ *   SMARTDEVICE_SYSFS_ROOT=<目录> SMARTDEVICE_CONFIG=<目录>/peripherals.ini ./my_qt
+ */
+#include "smartdevicemodule.h"
+#include "sysfsfilecache.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QTimer>
+
+#include <cstdio>
+
+static bool writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    return file.write(content) == content.size();
+}
+
+/**
+ * @brief 建立模拟的 sysfs 目录树和对应的外设配置文件
+ */
+static bool createFakeTree(const QString &root)
+{
+    const QString leds = root + "/sys/class/leds";
+    const QString ap3216c = root + "/sys/class/misc/ap3216c";
+    const QString alarm = root + "/sys/class/alarm/alarm0";
+    const QString imu = root + "/sys/bus/iio/devices/iio:device0";
+
+    QDir dir;
+    if (!dir.mkpath(leds + "/sys-led") || !dir.mkpath(leds + "/beep") || !dir.mkpath(alarm) ||
+        !dir.mkpath(ap3216c) || !dir.mkpath(imu) || !dir.mkpath(root + "/dev"))
+        return false;
+
+    // 只提供 none 触发器，BEEP 节奏走软件方式
+    bool ok = writeFile(leds + "/sys-led/trigger", "[none] timer heartbeat\n") &&
+              writeFile(leds + "/sys-led/brightness", "0\n") &&
+              writeFile(leds + "/beep/trigger", "[none]\n") &&
+              writeFile(leds + "/beep/brightness", "0\n") &&
+              writeFile(alarm + "/enable", "0\n") &&
+              writeFile(ap3216c + "/als", "1234\n") &&
+              writeFile(ap3216c + "/ps", "56\n") &&
+              writeFile(ap3216c + "/ir", "78\n");
+
+    // 没有 scan_elements/buffer，六轴采集回退到 sysfs 定时读取
+    ok = ok && writeFile(imu + "/name", "icm20608\n") &&
+         writeFile(imu + "/in_accel_scale", "0.000598\n") &&
+         writeFile(imu + "/in_anglvel_scale", "0.001064724\n") &&
+         writeFile(imu + "/sampling_frequency", "1000\n");
+    const char *raws[6] = {
+        "in_accel_x_raw", "in_accel_y_raw", "in_accel_z_raw",
+        "in_anglvel_x_raw", "in_anglvel_y_raw", "in_anglvel_z_raw"
+    };
+    const char *values[6] = { "120\n", "-340\n", "16384\n", "12\n", "-7\n", "3\n" };
+    for (int i = 0; i < 6 && ok; i++)
+        ok = writeFile(imu + "/" + raws[i], values[i]);
+
+    ok = ok && writeFile(root + "/peripherals.ini",
+                         "[led]\npath=/sys/class/leds/sys-led\n"
+                         "[beep]\npath=/sys/class/leds/beep\n"
+                         "[alarm]\npath=/sys/class/alarm/alarm0\n"
+                         "[ap3216c]\npath=/sys/class/misc/ap3216c\niio_name=ap3216c\n"
+                         "[imu]\niio_name=icm20608\n");
+    return ok;
+}
+
+static void runEventLoop(int ms)
+{
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+/**
+ * @brief LED 开关：常驻 fd（smartDeviceModule）与每次 open/write/close 对比
+ */
+static void benchToggles(smartDeviceModule &module, const QString &root)
+{
+    const int toggles = 200000;
+
+    const SysfsFileCache::Counters before = module.sysfsCounters();
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < toggles / 2; i++) {
+        module.turnLedOn();
+        module.turnLedOff();
+    }
+    const double seconds = timer.nsecsElapsed() / 1e9;
+    const SysfsFileCache::Counters after = module.sysfsCounters();
+
+    const double syscalls = (after.opens - before.opens) + (after.writes - before.writes) +
+                            (after.closes - before.closes);
+    printf("%-26s %12.0f /s %10.2f syscalls/op\n", "led toggle (cached fd)",
+           toggles / seconds, syscalls / toggles);
+
+    // 对照：每次都打开文件（open + write + close）
+    const QString path = root + "/sys/class/leds/sys-led/brightness";
+    const int naiveToggles = toggles / 10;
+    timer.restart();
+    for (int i = 0; i < naiveToggles; i++) {
+        QFile file(path);
+        if (file.open(QIODevice::WriteOnly))
+            file.write(i & 1 ? "0" : "1");
+    }
+    const double naiveSeconds = timer.nsecsElapsed() / 1e9;
+    printf("%-26s %12.0f /s %10.2f syscalls/op\n", "led toggle (open/close)",
+           naiveToggles / naiveSeconds, 3.0);
+}
+
+/**
+ * @brief AP3216C 读取路径：每个样本 3 次 pread
+ */
+static void benchAp3216cReads(const QString &root)
+{
+    const QString dir = root + "/sys/class/misc/ap3216c/";
+    SysfsFileCache files;
+    const int als = files.add(dir + "als", SysfsFileCache::Read);
+    const int ps = files.add(dir + "ps", SysfsFileCache::Read);
+    const int ir = files.add(dir + "ir", SysfsFileCache::Read);
+
+    const int samples = 200000;
+    quint32 sum = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < samples; i++) {
+        quint16 a = 0, p = 0, r = 0;
+        files.readUInt16(als, a);
+        files.readUInt16(ps, p);
+        files.readUInt16(ir, r);
+        sum += a + p + r;
+    }
+    const double seconds = timer.nsecsElapsed() / 1e9;
+
+    const SysfsFileCache::Counters &c = files.counters();
+    printf("%-26s %12.0f /s %10.2f syscalls/op (checksum %u)\n", "ap3216c read path",
+           samples / seconds, double(c.opens + c.reads + c.closes) / samples, sum);
+}
+
+/**
+ * @brief 采集线程在 durationMs 内送达的样本数
+ */
+static void benchAcquisition(smartDeviceModule &module, int durationMs)
+{
+    int apSamples = 0;
+    int imuSamples = 0;
+    int imuBatches = 0;
+    QObject::connect(&module, &smartDeviceModule::ap3216cSampleReady, [&](const Ap3216cSample &) {
+        apSamples++;
+    });
+    QObject::connect(&module, &smartDeviceModule::imuSamplesReady, [&](const Sensor6AxisBatch &batch) {
+        imuSamples += batch.size();
+        imuBatches++;
+    });
+
+    module.setCapture(true, 10);
+    module.setImuCapture(true, 1000, true);
+    runEventLoop(durationMs);
+    module.setCapture(false);
+    module.setImuCapture(false);
+
+    // 处理停止前排队的最后一批
+    QCoreApplication::processEvents();
+
+    const double seconds = durationMs / 1000.0;
+    printf("%-26s %12.0f /s\n", "ap3216c acquisition", apSamples / seconds);
+    printf("%-26s %12.0f /s %10.1f batches/s\n", "imu acquisition @1kHz",
+           imuSamples / seconds, imuBatches / seconds);
+}
+
+/**
+ * @brief 闹钟节奏：5 次 20 ms 响 + 20 ms 停，理论 200 ms
+ */
+static void benchAlarm(smartDeviceModule &module)
+{
+    QEventLoop loop;
+    QElapsedTimer timer;
+    QObject::connect(&module, &smartDeviceModule::alarmStopped, &loop, &QEventLoop::quit);
+    QTimer::singleShot(2000, &loop, &QEventLoop::quit);
+
+    timer.start();
+    module.startAlarm(5, 20);
+    loop.exec();
+
+    printf("%-26s %12.1f ms (expected 200.0 ms)\n", "alarm pattern", timer.nsecsElapsed() / 1e6);
+}
+
+/**
+ * @brief 六轴回放检查：录制文件经 setFakeSource() 回放，送达的 ax..gz 应与文件逐条一致
+ *        （启用滤波级，同时检查滤波不改写测量值）
+ */
+static bool benchImuReplay(const QString &root)
+{
+    const int records = 50;
+    QByteArray data;
+    for (int i = 0; i < records; i++) {
+        const float values[6] = { i * 0.01f, -i * 0.02f, 1.0f, i * 1.5f, -i * 0.5f, 10.0f + i };
+        data.append(reinterpret_cast<const char *>(values), sizeof(values));
+    }
+    const QString path = root + "/imu-replay.bin";
+    if (!writeFile(path, data)) {
+        printf("无法写入回放文件 %s\n", qPrintable(path));
+        return false;
+    }
+
+    int samples = 0;
+    int mismatches = 0;
+    qputenv("SMARTDEVICE_FAKE_IMU", QFile::encodeName(path));
+    {
+        smartDeviceModule module;
+        QObject::connect(&module, &smartDeviceModule::imuSamplesReady, [&](const Sensor6AxisBatch &batch) {
+            for (const Sensor6AxisData &sample : batch) {
+                const float *expected = reinterpret_cast<const float *>(data.constData()) + (samples % records) * 6;
+                if (sample.ax != expected[0] || sample.ay != expected[1] || sample.az != expected[2] ||
+                    sample.gx != expected[3] || sample.gy != expected[4] || sample.gz != expected[5])
+                    mismatches++;
+                samples++;
+            }
+        });
+
+        module.setImuCapture(true, 200, true);
+        runEventLoop(500);
+        module.setImuCapture(false);
+        QCoreApplication::processEvents();
+    }
+    qunsetenv("SMARTDEVICE_FAKE_IMU");
+
+    printf("%-26s %12d samples %6d mismatches\n", "imu replay (fake source)", samples, mismatches);
+    return samples > 0 && mismatches == 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QString root;
+    bool createOnly = false;
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); i++) {
+        if (args.at(i) == "--root" && i + 1 < args.size())
+            root = args.at(++i);
+        else if (args.at(i) == "--create-only")
+            createOnly = true;
+    }
+
+    // 默认放在 tmpfs 中，避免测到磁盘
+    if (root.isEmpty()) {
+        const QString base = QDir("/dev/shm").exists() ? "/dev/shm" : QDir::tempPath();
+        root = QString("%1/smartdevice-bench-%2").arg(base).arg(QCoreApplication::applicationPid());
+    }
+
+    if (!createFakeTree(root)) {
+        printf("无法建立模拟目录树 %s\n", qPrintable(root));
+        return 1;
+    }
+    if (createOnly) {
+        printf("SMARTDEVICE_SYSFS_ROOT=%s SMARTDEVICE_CONFIG=%s/peripherals.ini\n",
+               qPrintable(root), qPrintable(root));
+        return 0;
+    }
+
+    qputenv("SMARTDEVICE_SYSFS_ROOT", QFile::encodeName(root));
+    qputenv("SMARTDEVICE_CONFIG", QFile::encodeName(root + "/peripherals.ini"));
+
+    int ret = 0;
+    {
+        smartDeviceModule module;
+        printf("sysfs root: %s\n\n", qPrintable(module.peripherals().sysfsRoot()));
+
+        benchToggles(module, root);
+        benchAp3216cReads(root);
+        benchAcquisition(module, 2000);
+        benchAlarm(module);
+
+        if (module.sysfsCounters().failures != 0) {
+            printf("\nsysfs 写入失败 %llu 次\n", module.sysfsCounters().failures);
+            ret = 1;
+        }
+    }
+
+    if (!benchImuReplay(root))
+        ret = 1;
+
+    QDir(root).removeRecursively();
+    return ret;
+}
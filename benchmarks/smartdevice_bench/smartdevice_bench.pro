@@ -0,0 +1,35 @@
+# smartDeviceModule 外设 I/O 性能测试（在模拟 sysfs 目录树上运行，无需开发板）
+# 构建: qmake && make && ./smartdevice_bench [--root <目录>] [--create-only]
+
+TEMPLATE = app
+TARGET = smartdevice_bench
+QT = core
+CONFIG += console c++14
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../ap3216cacquisition.cpp \
+    ../../beeppatternplayer.cpp \
+    ../../crc16.cpp \
+    ../../iiobufferreader.cpp \
+    ../../imuacquisition.cpp \
+    ../../imufilter.cpp \
+    ../../peripheralregistry.cpp \
+    ../../sensorlog.cpp \
+    ../../smartdevicemodule.cpp \
+    ../../sysfsfilecache.cpp
+
+HEADERS += \
+    ../../ap3216cacquisition.h \
+    ../../beeppatternplayer.h \
+    ../../crc16.h \
+    ../../iiobufferreader.h \
+    ../../imuacquisition.h \
+    ../../imufilter.h \
+    ../../peripheralregistry.h \
+    ../../sensorlog.h \
+    ../../smartdevicemodule.h \
+    ../../sysfsfilecache.h
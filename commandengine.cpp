@@ -0,0 +1,209 @@
+#include "commandengine.h"
+#include "serialmodule.h"
+
+const int CommandEngine::LatencyHistogram::kBuckets;
+
+/* ================= 延时直方图 ================= */
+
+void CommandEngine::LatencyHistogram::add(quint32 us)
+{
+    int bucket = 0;
+    while (bucket < kBuckets - 1 && us >= bucketUpperUs(bucket))
+        bucket++;
+    counts[bucket]++;
+
+    if (samples == 0 || us < minUs) minUs = us;
+    if (us > maxUs) maxUs = us;
+    samples++;
+    totalUs += us;
+}
+
+quint32 CommandEngine::LatencyHistogram::percentileUs(double p) const
+{
+    if (samples == 0) return 0;
+
+    const quint64 target = static_cast<quint64>(p * samples + 0.5);
+    quint64 acc = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        acc += counts[i];
+        if (acc >= target)
+            return qMin(bucketUpperUs(i), maxUs);
+    }
+    return maxUs;
+}
+
+/* ================= 指令引擎 ================= */
+
+CommandEngine::CommandEngine(serialModule *serial, QObject *parent)
+    : QObject(parent), m_serial(serial)
+{
+    m_clock.start();
+
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &CommandEngine::onTimeout);
+
+    connect(m_serial, &serialModule::frameReceived, this, &CommandEngine::onFrameReceived);
+    connect(m_serial, &serialModule::serialClosed, this, [=]() {
+        cancelAll("串口已关闭");
+    });
+}
+
+CommandEngine::~CommandEngine()
+{
+}
+
+void CommandEngine::setWindowSize(int size)
+{
+    m_windowSize = qMax(1, size);
+    pump();
+}
+
+void CommandEngine::setTimeout(int ms)
+{
+    m_timeoutMs = qMax(1, ms);
+    rearmTimer();
+}
+
+void CommandEngine::setMaxRetries(int retries)
+{
+    m_maxRetries = qMax(0, retries);
+}
+
+/**
+ * @brief 提交指令，窗口未满时立即发送
+ */
+quint32 CommandEngine::submit(quint16 cmd, const QByteArray &payload)
+{
+    // 超长的扩展数据永远发不出去，不进入队列等超时
+    if (payload.size() > serialModule::kMaxPayloadSize)
+        return 0;
+
+    Pending p;
+    p.id = m_nextId++;
+    p.cmd = cmd;
+    p.payload = payload;
+    m_waiting.enqueue(p);
+
+    pump();
+    return p.id;
+}
+
+void CommandEngine::cancelAll(const QString &reason)
+{
+    m_timer.stop();
+
+    // 先取出再通知，避免槽函数中重新提交造成混乱
+    QList<Pending> cancelled = m_inFlight;
+    cancelled.append(m_waiting);
+    m_inFlight.clear();
+    m_waiting.clear();
+
+    for (const Pending &p : cancelled)
+        emit commandFailed(p.id, p.cmd, reason);
+}
+
+/**
+ * @brief 窗口未满时把排队指令发出去（流水线，不等待上一条应答）
+ */
+void CommandEngine::pump()
+{
+    while (m_inFlight.size() < m_windowSize && !m_waiting.isEmpty()) {
+        if (!m_serial->isOpen()) {
+            cancelAll("串口未打开");
+            return;
+        }
+
+        Pending p = m_waiting.dequeue();
+        if (transmit(p))
+            m_inFlight.append(p);
+        else
+            emit commandFailed(p.id, p.cmd, "发送失败");
+    }
+    rearmTimer();
+}
+
+bool CommandEngine::transmit(Pending &p)
+{
+    QByteArray frame;
+    if (!m_serial->sendCommand(p.cmd, p.payload, &frame))
+        return false;
+
+    p.attempts++;
+    p.sentUs = nowUs();
+    emit commandSent(p.id, p.cmd, frame, p.attempts);
+    return true;
+}
+
+/**
+ * @brief 定时器对准最早发送的在途指令的超时时刻
+ */
+void CommandEngine::rearmTimer()
+{
+    if (m_inFlight.isEmpty()) {
+        m_timer.stop();
+        return;
+    }
+
+    qint64 dueUs = m_inFlight.first().sentUs + static_cast<qint64>(m_timeoutMs) * 1000;
+    qint64 waitMs = (dueUs - nowUs() + 999) / 1000;
+    m_timer.start(static_cast<int>(qMax<qint64>(0, waitMs)));
+}
+
+/**
+ * @brief 收到应答帧：匹配最早发出的同码指令
+ */
+void CommandEngine::onFrameReceived(quint16 cmd, const QByteArray &payload)
+{
+    for (int i = 0; i < m_inFlight.size(); ++i) {
+        if (m_inFlight.at(i).cmd != cmd)
+            continue;
+
+        Pending p = m_inFlight.takeAt(i);
+        qint64 latencyUs = nowUs() - p.sentUs;
+        m_latency[cmd].add(static_cast<quint32>(qMin<qint64>(latencyUs, 0xFFFFFFFF)));
+
+        emit commandCompleted(p.id, p.cmd, payload, latencyUs);
+        pump();
+        return;
+    }
+    // 非应答帧（设备主动上报）不处理
+}
+
+/**
+ * @brief 超时处理：重发或报告失败
+ */
+void CommandEngine::onTimeout()
+{
+    const qint64 now = nowUs();
+    const qint64 timeoutUs = static_cast<qint64>(m_timeoutMs) * 1000;
+
+    // m_inFlight 按发送时间排序，只需检查队首
+    while (!m_inFlight.isEmpty() && now - m_inFlight.first().sentUs >= timeoutUs) {
+        Pending p = m_inFlight.takeFirst();
+
+        if (p.attempts <= m_maxRetries && transmit(p)) {
+            m_inFlight.append(p);   // 重新发送后排到队尾
+            emit commandRetried(p.id, p.cmd, p.attempts);
+        } else {
+            emit commandFailed(p.id, p.cmd, QString("应答超时（已发送 %1 次）").arg(p.attempts));
+        }
+    }
+
+    pump();
+}
+
+CommandEngine::LatencyHistogram CommandEngine::latency(quint16 cmd) const
+{
+    return m_latency.value(cmd);
+}
+
+QList<quint16> CommandEngine::trackedCommands() const
+{
+    return m_latency.keys();
+}
+
+void CommandEngine::resetStatistics()
+{
+    m_latency.clear();
+}
@@ -0,0 +1,113 @@
+#ifndef COMMANDENGINE_H
+#define COMMANDENGINE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QQueue>
+#include <QTimer>
+
+class serialModule;
+
+/**
+ * @brief 串口指令引擎（请求/应答）
+ *
+ * 基于 serialModule::sendCommand() 与 frameReceived 信号：
+ * - 按指令码跟踪已发出的指令，收到相同指令码的应答帧即视为完成（同码按发送顺序匹配）
+ * - 可配置同时在途的指令数（窗口），窗口未满时无需等待上一条应答即可继续发送
+ * - 超时自动重发，超过重发次数后报告失败
+ * - 按指令码统计应答延时直方图
+ */
+class CommandEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 应答延时直方图（对数分桶），第 i 个桶上界为 128<<i 微秒，最后一个桶收集更大的值
+     */
+    struct LatencyHistogram {
+        static const int kBuckets = 16;
+        quint32 counts[kBuckets] = {};  ///< 各桶计数
+        quint32 samples = 0;            ///< 样本数
+        quint64 totalUs = 0;            ///< 延时总和（微秒）
+        quint32 minUs = 0;              ///< 最小延时
+        quint32 maxUs = 0;              ///< 最大延时
+
+        void add(quint32 us);
+        double meanUs() const { return samples ? static_cast<double>(totalUs) / samples : 0.0; }
+        quint32 percentileUs(double p) const;   ///< 近似分位数（桶上界）
+        static quint32 bucketUpperUs(int bucket) { return 64u << (bucket + 1); }
+    };
+
+    explicit CommandEngine(serialModule *serial, QObject *parent = nullptr);
+    ~CommandEngine();
+
+    // ================= 配置 =================
+    void setWindowSize(int size);       ///< 同时在途的指令数，默认 4
+    void setTimeout(int ms);            ///< 单次应答超时，默认 200 ms
+    void setMaxRetries(int retries);    ///< 超时重发次数，默认 2
+    int windowSize() const { return m_windowSize; }
+    int timeout() const { return m_timeoutMs; }
+    int maxRetries() const { return m_maxRetries; }
+
+    /**
+     * @brief 提交一条指令
+     * @return 指令编号，用于匹配 commandSent/commandCompleted/commandFailed；
+     *         扩展数据超过 serialModule::kMaxPayloadSize 时不提交，返回 0
+     */
+    quint32 submit(quint16 cmd, const QByteArray &payload = QByteArray());
+
+    /**
+     * @brief 取消所有排队和在途的指令（逐条发出 commandFailed）
+     */
+    void cancelAll(const QString &reason);
+
+    int inFlightCount() const { return m_inFlight.size(); }
+    int queuedCount() const { return m_waiting.size(); }
+
+    // ================= 统计 =================
+    LatencyHistogram latency(quint16 cmd) const;
+    QList<quint16> trackedCommands() const;
+    void resetStatistics();
+
+signals:
+    void commandSent(quint32 id, quint16 cmd, const QByteArray &frame, int attempt); ///< frame 为实际写入发送队列的整帧
+    void commandCompleted(quint32 id, quint16 cmd, const QByteArray &reply, qint64 latencyUs);
+    void commandFailed(quint32 id, quint16 cmd, const QString &reason);
+    void commandRetried(quint32 id, quint16 cmd, int attempt);
+
+private slots:
+    void onFrameReceived(quint16 cmd, const QByteArray &payload);
+    void onTimeout();
+
+private:
+    struct Pending {
+        quint32 id = 0;
+        quint16 cmd = 0;
+        QByteArray payload;
+        int attempts = 0;       ///< 已发送次数
+        qint64 sentUs = 0;      ///< 最近一次发送时间
+    };
+
+    void pump();                ///< 窗口未满时继续发送排队指令
+    bool transmit(Pending &p);  ///< 发送失败返回 false
+    void rearmTimer();          ///< 定时器对准最早的超时时刻
+    qint64 nowUs() const { return m_clock.nsecsElapsed() / 1000; }
+
+    serialModule *m_serial;
+    QQueue<Pending> m_waiting;  ///< 等待发送
+    QList<Pending> m_inFlight;  ///< 已发送等待应答，按发送时间排序
+    QHash<quint16, LatencyHistogram> m_latency;
+
+    QElapsedTimer m_clock;
+    QTimer m_timer;             ///< 超时定时器（单次）
+    quint32 m_nextId = 1;
+    int m_windowSize = 4;
+    int m_timeoutMs = 200;
+    int m_maxRetries = 2;
+};
+
+#endif // COMMANDENGINE_H
@@ -0,0 +1,88 @@
+#include "crc16.h"
+
+namespace {
+
+/* ================= 编译期生成查表 ================= */
+struct Crc16Tables {
+    uint16_t t[8][256];
+};
+
+constexpr Crc16Tables makeCrc16Tables()
+{
+    Crc16Tables r{};
+
+    // t[0]：单字节查表
+    for (int i = 0; i < 256; i++) {
+        uint16_t crc = static_cast<uint16_t>(i);
+        for (int j = 0; j < 8; j++)
+            crc = (crc & 0x0001) ? static_cast<uint16_t>((crc >> 1) ^ 0xA001) : static_cast<uint16_t>(crc >> 1);
+        r.t[0][i] = crc;
+    }
+
+    // t[k]：该字节之后再跟 k 个 0x00 字节时的贡献，用于 slice-by-8
+    for (int k = 1; k < 8; k++) {
+        for (int i = 0; i < 256; i++) {
+            uint16_t prev = r.t[k - 1][i];
+            r.t[k][i] = static_cast<uint16_t>((prev >> 8) ^ r.t[0][prev & 0xFF]);
+        }
+    }
+    return r;
+}
+
+constexpr Crc16Tables kCrc16 = makeCrc16Tables();
+
+static_assert(kCrc16.t[0][1] == 0xC0C1, "CRC16/Modbus 查表生成错误");
+
+} // namespace
+
+/**
+ * @brief 逐位计算（参考实现）
+ */
+uint16_t crc16_bitwise(const uint8_t *data, size_t len, uint16_t crc)
+{
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t j = 0; j < 8; j++) {
+            if (crc & 0x0001)
+                crc = (crc >> 1) ^ 0xA001;
+            else
+                crc >>= 1;
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief 单字节查表
+ */
+uint16_t crc16_table(const uint8_t *data, size_t len, uint16_t crc)
+{
+    const uint16_t *t0 = kCrc16.t[0];
+    for (size_t i = 0; i < len; i++)
+        crc = static_cast<uint16_t>((crc >> 8) ^ t0[(crc ^ data[i]) & 0xFF]);
+    return crc;
+}
+
+/**
+ * @brief slice-by-8：每轮 8 次独立查表，消除逐字节的数据依赖
+ */
+uint16_t crc16_slice8(const uint8_t *data, size_t len, uint16_t crc)
+{
+    const uint16_t (*t)[256] = kCrc16.t;
+
+    while (len >= 8) {
+        // CRC 只有 16 位，只与前两个字节异或，其余 6 个字节直接查表
+        crc = static_cast<uint16_t>(t[7][(crc ^ data[0]) & 0xFF] ^
+                                    t[6][((crc >> 8) ^ data[1]) & 0xFF] ^
+                                    t[5][data[2]] ^
+                                    t[4][data[3]] ^
+                                    t[3][data[4]] ^
+                                    t[2][data[5]] ^
+                                    t[1][data[6]] ^
+                                    t[0][data[7]]);
+        data += 8;
+        len -= 8;
+    }
+
+    return crc16_table(data, len, crc);
+}
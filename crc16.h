@@ -0,0 +1,39 @@
+#ifndef CRC16_H
+#define CRC16_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * CRC16/Modbus（多项式 0xA001 反射，初值 0xFFFF）
+ *
+ * 提供三种等价实现：
+ *  - crc16_bitwise : 逐位计算，每字节 8 次移位，仅作参考
+ *  - crc16_table   : 256 项查表，每字节一次查表
+ *  - crc16_slice8  : slice-by-8，每次处理 8 字节，适合大块数据（固件升级帧）
+ *
+ * crc16_modbus() 在编译期选择其中一种，可在 .pro 中通过
+ *   DEFINES += CRC16_IMPL_BITWISE / CRC16_IMPL_TABLE / CRC16_IMPL_SLICE8
+ * 指定，默认使用 slice-by-8。
+ *
+ * 所有实现都支持传入上一次的结果作为 crc，用于分段累计计算。
+ */
+
+#define CRC16_MODBUS_INIT 0xFFFF
+
+uint16_t crc16_bitwise(const uint8_t *data, size_t len, uint16_t crc = CRC16_MODBUS_INIT);
+uint16_t crc16_table(const uint8_t *data, size_t len, uint16_t crc = CRC16_MODBUS_INIT);
+uint16_t crc16_slice8(const uint8_t *data, size_t len, uint16_t crc = CRC16_MODBUS_INIT);
+
+inline uint16_t crc16_modbus(const uint8_t *data, size_t len, uint16_t crc = CRC16_MODBUS_INIT)
+{
+#if defined(CRC16_IMPL_BITWISE)
+    return crc16_bitwise(data, len, crc);
+#elif defined(CRC16_IMPL_TABLE)
+    return crc16_table(data, len, crc);
+#else
+    return crc16_slice8(data, len, crc);
+#endif
+}
+
+#endif // CRC16_H
@@ -0,0 +1,168 @@
+#include "hexcodec.h"
+
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define HEXCODEC_HAVE_NEON
+#endif
+
+namespace {
+
+/* ================= 编译期生成查表 ================= */
+const char kHexDigits[] = "0123456789ABCDEF";
+
+constexpr int8_t kHexSkip = -1;     ///< 空白字符，解码时跳过
+constexpr int8_t kHexInvalid = -2;  ///< 非法字符
+
+struct HexTables {
+    char pair[256][2];     ///< 字节 -> 两位十六进制字符
+    int8_t nibble[256];    ///< 字符 -> 0~15 / kHexSkip / kHexInvalid
+    char printable[256];   ///< 字节 -> 可打印字符或 '.'
+};
+
+constexpr HexTables makeHexTables()
+{
+    HexTables r{};
+
+    for (int i = 0; i < 256; i++) {
+        r.pair[i][0] = kHexDigits[i >> 4];
+        r.pair[i][1] = kHexDigits[i & 0x0F];
+
+        if (i >= '0' && i <= '9')
+            r.nibble[i] = static_cast<int8_t>(i - '0');
+        else if (i >= 'A' && i <= 'F')
+            r.nibble[i] = static_cast<int8_t>(i - 'A' + 10);
+        else if (i >= 'a' && i <= 'f')
+            r.nibble[i] = static_cast<int8_t>(i - 'a' + 10);
+        else if (i == ' ' || i == '\t' || i == '\r' || i == '\n')
+            r.nibble[i] = kHexSkip;
+        else
+            r.nibble[i] = kHexInvalid;
+
+        r.printable[i] = (i >= 32 && i <= 126) ? static_cast<char>(i) : '.';
+    }
+    return r;
+}
+
+constexpr HexTables kHex = makeHexTables();
+
+static_assert(kHex.pair[0xA5][0] == 'A' && kHex.pair[0xA5][1] == '5', "十六进制查表生成错误");
+static_assert(kHex.nibble['f'] == 15 && kHex.nibble['g'] == kHexInvalid, "十六进制查表生成错误");
+
+/**
+ * @brief 解码主循环，char 与 UTF-16 共用
+ */
+template <typename Char>
+bool decode(const Char *src, size_t len, uint8_t *dst, size_t *outLen)
+{
+    size_t n = 0;
+    int high = -1; // 已读入的高半字节，-1 表示没有
+
+    for (size_t i = 0; i < len; i++) {
+        const uint32_t c = static_cast<uint32_t>(src[i]);
+        const int v = c < 256 ? kHex.nibble[c] : kHexInvalid;
+        if (v >= 0) {
+            if (high < 0) {
+                high = v;
+            } else {
+                dst[n++] = static_cast<uint8_t>((high << 4) | v);
+                high = -1;
+            }
+        } else if (v == kHexInvalid) {
+            return false;
+        }
+    }
+
+    *outLen = n;
+    return high < 0;
+}
+
+} // namespace
+
+/**
+ * @brief 查表编码，每字节一次查表
+ */
+size_t hex_encode_scalar(const uint8_t *src, size_t len, char *dst, char separator)
+{
+    if (len == 0) return 0;
+
+    char *out = dst;
+    if (separator) {
+        for (size_t i = 0; i + 1 < len; i++) {
+            memcpy(out, kHex.pair[src[i]], 2);
+            out[2] = separator;
+            out += 3;
+        }
+        memcpy(out, kHex.pair[src[len - 1]], 2);
+        out += 2;
+    } else {
+        for (size_t i = 0; i < len; i++) {
+            memcpy(out, kHex.pair[src[i]], 2);
+            out += 2;
+        }
+    }
+    return static_cast<size_t>(out - dst);
+}
+
+/**
+ * @brief 编码：NEON 平台每次处理 8 字节（vtbl 查字符、vst2/vst3 交织写出），
+ *        其余部分与非 NEON 平台使用查表实现
+ */
+size_t hex_encode(const uint8_t *src, size_t len, char *dst, char separator)
+{
+#ifdef HEXCODEC_HAVE_NEON
+    const uint8x8x2_t digits = { { vld1_u8(reinterpret_cast<const uint8_t *>(kHexDigits)),
+                                   vld1_u8(reinterpret_cast<const uint8_t *>(kHexDigits) + 8) } };
+    const uint8x8_t mask = vdup_n_u8(0x0F);
+    uint8_t *out = reinterpret_cast<uint8_t *>(dst);
+    size_t i = 0;
+
+    if (separator) {
+        // 每块写出 24 字节，最后一个分隔符属于下一字节，所以块后至少还要剩 1 字节
+        const uint8x8_t sep = vdup_n_u8(static_cast<uint8_t>(separator));
+        for (; i + 8 < len; i += 8) {
+            const uint8x8_t v = vld1_u8(src + i);
+            uint8x8x3_t r;
+            r.val[0] = vtbl2_u8(digits, vshr_n_u8(v, 4));
+            r.val[1] = vtbl2_u8(digits, vand_u8(v, mask));
+            r.val[2] = sep;
+            vst3_u8(out, r);
+            out += 24;
+        }
+    } else {
+        for (; i + 8 <= len; i += 8) {
+            const uint8x8_t v = vld1_u8(src + i);
+            uint8x8x2_t r;
+            r.val[0] = vtbl2_u8(digits, vshr_n_u8(v, 4));
+            r.val[1] = vtbl2_u8(digits, vand_u8(v, mask));
+            vst2_u8(out, r);
+            out += 16;
+        }
+    }
+
+    const size_t head = static_cast<size_t>(out - reinterpret_cast<uint8_t *>(dst));
+    return head + hex_encode_scalar(src + i, len - i, dst + head, separator);
+#else
+    return hex_encode_scalar(src, len, dst, separator);
+#endif
+}
+
+bool hex_decode(const char *src, size_t len, uint8_t *dst, size_t *outLen)
+{
+    return decode(reinterpret_cast<const uint8_t *>(src), len, dst, outLen);
+}
+
+bool hex_decode(const uint16_t *src, size_t len, uint8_t *dst, size_t *outLen)
+{
+    return decode(src, len, dst, outLen);
+}
+
+/**
+ * @brief 不可打印字符替换为 '.'，查表完成
+ */
+void ascii_printable(const uint8_t *src, size_t len, char *dst)
+{
+    for (size_t i = 0; i < len; i++)
+        dst[i] = kHex.printable[src[i]];
+}
@@ -0,0 +1,50 @@
+#ifndef HEXCODEC_H
+#define HEXCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * 十六进制编解码（串口页面的发送/接收显示共用）
+ *
+ *  - hex_encode        : 字节 -> 大写十六进制文本，可选字节间分隔符，查表单遍完成；
+ *                        编译目标支持 NEON 时每次处理 8 字节
+ *  - hex_encode_scalar : 纯查表实现，作为参考与非 NEON 平台的实现
+ *  - hex_decode        : 十六进制文本 -> 字节，单遍查表，跳过空白字符，
+ *                        非法字符或半个字节时失败
+ *  - ascii_printable   : 不可打印字符替换为 '.'
+ *
+ * 所有函数只写入调用者提供的缓冲区，不做内存分配。
+ */
+
+/**
+ * @brief 编码输出长度（分隔符只出现在字节之间）
+ */
+inline size_t hex_encoded_size(size_t len, char separator)
+{
+    if (len == 0) return 0;
+    return separator ? len * 3 - 1 : len * 2;
+}
+
+/**
+ * @brief 解码输出长度上限
+ */
+inline size_t hex_decoded_max_size(size_t len)
+{
+    return len / 2;
+}
+
+size_t hex_encode_scalar(const uint8_t *src, size_t len, char *dst, char separator = ' ');
+size_t hex_encode(const uint8_t *src, size_t len, char *dst, char separator = ' ');
+
+/**
+ * @brief 解码十六进制文本（Latin-1 或 UTF-16，后者可直接传入 QString::utf16()）
+ * @param outLen 输出字节数
+ * @return false=含非法字符或十六进制位数为奇数
+ */
+bool hex_decode(const char *src, size_t len, uint8_t *dst, size_t *outLen);
+bool hex_decode(const uint16_t *src, size_t len, uint8_t *dst, size_t *outLen);
+
+void ascii_printable(const uint8_t *src, size_t len, char *dst);
+
+#endif // HEXCODEC_H
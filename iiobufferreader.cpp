@@ -0,0 +1,286 @@
+#include "iiobufferreader.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <algorithm>
+#include <cstdio>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+IioBufferReader::~IioBufferReader()
+{
+    close();
+}
+
+QByteArray IioBufferReader::readAttr(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll().trimmed();
+}
+
+bool IioBufferReader::writeAttr(const QString &path, const QByteArray &value)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    return file.write(value) == value.size();
+}
+
+QString IioBufferReader::findDevice(const QString &name, const QString &root)
+{
+    QDir dir(root);
+    const QStringList devices = dir.entryList(QStringList() << "iio:device*", QDir::Dirs | QDir::System);
+    for (const QString &device : devices) {
+        const QString path = dir.filePath(device);
+        if (readAttr(path + "/name") == name.toLatin1())
+            return path;
+    }
+    return QString();
+}
+
+/**
+ * @brief 解析 scan 元素格式："[be|le]:[s|u]bits/storagebits[Xrepeat][>>shift]"
+ */
+bool IioBufferReader::parseType(const QByteArray &type, Channel &channel)
+{
+    char endian[3] = {};
+    char sign = 0;
+    int bits = 0, storage = 0, shift = 0;
+
+    if (sscanf(type.constData(), "%2[bl]e:%c%d/%d>>%d", endian, &sign, &bits, &storage, &shift) < 4) {
+        // 带 repeat 的格式（如 "le:s16/16X3>>0"）暂不支持
+        return false;
+    }
+    if (storage != 8 && storage != 16 && storage != 32 && storage != 64)
+        return false;
+
+    channel.bigEndian = endian[0] == 'b';
+    channel.isSigned = sign == 's';
+    channel.bits = bits;
+    channel.storageBytes = storage / 8;
+    channel.shift = shift;
+    return true;
+}
+
+bool IioBufferReader::enableChannel(const QString &name, bool enable)
+{
+    const QString path = m_deviceDir + "/scan_elements/" + name + "_en";
+    if (readAttr(path) == (enable ? "1" : "0"))
+        return true;
+    return writeAttr(path, enable ? "1" : "0");
+}
+
+/**
+ * @brief 读取通道的 index/type/scale/offset
+ */
+bool IioBufferReader::setupChannel(const QString &name, Channel &channel)
+{
+    const QString scanDir = m_deviceDir + "/scan_elements/";
+
+    channel.name = name;
+    bool ok = false;
+    channel.index = readAttr(scanDir + name + "_index").toInt(&ok);
+    if (!ok || !parseType(readAttr(scanDir + name + "_type"), channel))
+        return false;
+
+    // scale/offset 可能按通道提供，也可能同类共享（in_accel_x -> in_accel_scale）
+    const QString shared = name.left(name.lastIndexOf('_'));
+    QByteArray scale = readAttr(m_deviceDir + "/" + name + "_scale");
+    if (scale.isEmpty())
+        scale = readAttr(m_deviceDir + "/" + shared + "_scale");
+    channel.scale = scale.isEmpty() ? 1.0 : scale.toDouble();
+
+    QByteArray offset = readAttr(m_deviceDir + "/" + name + "_offset");
+    if (offset.isEmpty())
+        offset = readAttr(m_deviceDir + "/" + shared + "_offset");
+    channel.valueOffset = offset.isEmpty() ? 0.0 : offset.toDouble();
+    return true;
+}
+
+/**
+ * @brief 设备需要触发器但尚未设置时，选择与设备同名的触发器（如 "icm20608-dev0"）
+ */
+bool IioBufferReader::selectTrigger()
+{
+    const QString current = m_deviceDir + "/trigger/current_trigger";
+    if (!QFileInfo::exists(current) || !readAttr(current).isEmpty())
+        return true;
+
+    const QByteArray deviceName = readAttr(m_deviceDir + "/name");
+    QDir root(QFileInfo(m_deviceDir).absolutePath());
+    const QStringList triggers = root.entryList(QStringList() << "trigger*", QDir::Dirs | QDir::System);
+    for (const QString &trigger : triggers) {
+        const QByteArray name = readAttr(root.filePath(trigger) + "/name");
+        if (name.startsWith(deviceName))
+            return writeAttr(current, name);
+    }
+    return false;
+}
+
+bool IioBufferReader::open(const QString &deviceDir, const QStringList &channels,
+                           int bufferLength, const QString &devRoot)
+{
+    close();
+    m_deviceDir = deviceDir;
+    m_channels.clear();
+    m_timestamp = Channel();
+    m_scanSize = 0;
+
+    // 修改 scan 配置前必须先停用缓冲区
+    writeAttr(m_deviceDir + "/buffer/enable", "0");
+
+    // 只启用需要的通道（和时间戳），其余通道关闭，保证 scan 布局确定
+    QDir scanDir(m_deviceDir + "/scan_elements");
+    const QStringList enables = scanDir.entryList(QStringList() << "*_en", QDir::Files);
+    if (enables.isEmpty()) {
+        m_error = QString("%1 不支持缓冲模式").arg(m_deviceDir);
+        return false;
+    }
+
+    QVector<Channel> enabled;
+    for (const QString &file : enables) {
+        const QString name = file.left(file.size() - 3);
+        const bool isTimestamp = name == "in_timestamp";
+        const bool wanted = isTimestamp || channels.contains(name);
+        if (!enableChannel(name, wanted)) {
+            m_error = QString("无法设置通道 %1").arg(name);
+            return false;
+        }
+        if (!wanted)
+            continue;
+
+        Channel channel;
+        if (!setupChannel(name, channel)) {
+            m_error = QString("无法解析通道格式 %1").arg(name);
+            return false;
+        }
+        enabled.append(channel);
+    }
+
+    // 按 index 排列，每个元素按自身存储宽度对齐，整个 scan 按最大宽度对齐
+    std::sort(enabled.begin(), enabled.end(),
+              [](const Channel &a, const Channel &b) { return a.index < b.index; });
+    int offset = 0;
+    int largest = 1;
+    for (Channel &channel : enabled) {
+        offset = (offset + channel.storageBytes - 1) / channel.storageBytes * channel.storageBytes;
+        channel.offset = offset;
+        offset += channel.storageBytes;
+        largest = qMax(largest, channel.storageBytes);
+
+        if (channel.name == "in_timestamp")
+            m_timestamp = channel;
+    }
+    m_scanSize = (offset + largest - 1) / largest * largest;
+
+    for (const QString &name : channels) {
+        auto it = std::find_if(enabled.begin(), enabled.end(),
+                               [&name](const Channel &c) { return c.name == name; });
+        if (it == enabled.end()) {
+            m_error = QString("设备没有通道 %1").arg(name);
+            return false;
+        }
+        m_channels.append(*it);
+    }
+
+    selectTrigger();
+    writeAttr(m_deviceDir + "/buffer/length", QByteArray::number(bufferLength));
+    if (!writeAttr(m_deviceDir + "/buffer/enable", "1")) {
+        m_error = QString("无法启用缓冲区 %1").arg(m_deviceDir);
+        return false;
+    }
+
+    const QByteArray devPath = QFile::encodeName(devRoot + "/" + QFileInfo(m_deviceDir).fileName());
+    m_fd = ::open(devPath.constData(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (m_fd < 0) {
+        m_error = QString("无法打开 %1: %2").arg(QString::fromLocal8Bit(devPath)).arg(strerror(errno));
+        writeAttr(m_deviceDir + "/buffer/enable", "0");
+        return false;
+    }
+    return true;
+}
+
+void IioBufferReader::close()
+{
+    if (m_fd < 0)
+        return;
+
+    ::close(m_fd);
+    m_fd = -1;
+    writeAttr(m_deviceDir + "/buffer/enable", "0");
+}
+
+int IioBufferReader::read(uint8_t *buf, int size)
+{
+    if (m_fd < 0 || m_scanSize <= 0)
+        return -1;
+
+    const int want = size / m_scanSize * m_scanSize;
+    if (want <= 0)
+        return 0;
+
+    ssize_t n;
+    do {
+        n = ::read(m_fd, buf, static_cast<size_t>(want));
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0)
+        return errno == EAGAIN ? 0 : -1;
+    return static_cast<int>(n) / m_scanSize;
+}
+
+int IioBufferReader::channelIndex(const QString &name) const
+{
+    for (int i = 0; i < m_channels.size(); ++i) {
+        if (m_channels.at(i).name == name)
+            return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief 按字节序取出存储单元，移位、截取有效位并做符号扩展
+ */
+int64_t IioBufferReader::decode(const uint8_t *scan, const Channel &channel) const
+{
+    const uint8_t *p = scan + channel.offset;
+    uint64_t v = 0;
+    if (channel.bigEndian) {
+        for (int i = 0; i < channel.storageBytes; ++i)
+            v = (v << 8) | p[i];
+    } else {
+        for (int i = channel.storageBytes - 1; i >= 0; --i)
+            v = (v << 8) | p[i];
+    }
+
+    v >>= channel.shift;
+    if (channel.bits < 64) {
+        const uint64_t mask = (uint64_t(1) << channel.bits) - 1;
+        v &= mask;
+        if (channel.isSigned && (v >> (channel.bits - 1)) & 1)
+            v |= ~mask;
+    }
+    return static_cast<int64_t>(v);
+}
+
+int64_t IioBufferReader::raw(const uint8_t *scan, int channel) const
+{
+    return decode(scan, m_channels.at(channel));
+}
+
+double IioBufferReader::value(const uint8_t *scan, int channel) const
+{
+    const Channel &c = m_channels.at(channel);
+    return (static_cast<double>(decode(scan, c)) + c.valueOffset) * c.scale;
+}
+
+int64_t IioBufferReader::timestampNs(const uint8_t *scan) const
+{
+    return hasTimestamp() ? decode(scan, m_timestamp) : 0;
+}
@@ -0,0 +1,110 @@
+#ifndef IIOBUFFERREADER_H
+#define IIOBUFFERREADER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <cstdint>
+
+/**
+ * @brief IIO 缓冲模式读取器
+ *
+ * 通过 sysfs 配置 IIO 设备的 scan_elements 与 buffer，
+ * 然后从字符设备 /dev/iio:deviceN 批量读取扫描数据（scan）：
+ * - 解析 in_xxx_type（如 "le:s16/16>>0"），按 index 排序并按存储宽度对齐计算偏移
+ * - 读取 in_xxx_scale / in_xxx_offset（通道或同类共享），用于换算物理量
+ * - 字符设备以非阻塞方式打开，由调用者 poll() 后调用 read()
+ *
+ * 不依赖事件循环，可在任意线程中使用（同一实例只应在一个线程中使用）。
+ */
+class IioBufferReader
+{
+public:
+    /**
+     * @brief 一个扫描通道的格式
+     */
+    struct Channel {
+        QString name;          ///< 通道名，如 "in_accel_x"
+        int index = 0;         ///< scan 中的顺序
+        int offset = 0;        ///< 在 scan 中的字节偏移
+        int storageBytes = 0;  ///< 存储宽度（字节）
+        int bits = 0;          ///< 有效位数
+        int shift = 0;         ///< 右移位数
+        bool isSigned = false;
+        bool bigEndian = false;
+        double scale = 1.0;    ///< 物理量 = (原始值 + valueOffset) * scale
+        double valueOffset = 0;
+    };
+
+    IioBufferReader() = default;
+    ~IioBufferReader();
+
+    IioBufferReader(const IioBufferReader &) = delete;
+    IioBufferReader &operator=(const IioBufferReader &) = delete;
+
+    /**
+     * @brief 按 name 属性查找 IIO 设备
+     * @param name 设备名（如 "ap3216c"、"icm20608"）
+     * @param root IIO 设备目录
+     * @return 设备 sysfs 目录，未找到返回空字符串
+     */
+    static QString findDevice(const QString &name, const QString &root = "/sys/bus/iio/devices");
+
+    /**
+     * @brief 启用指定通道并打开缓冲区
+     * @param deviceDir 设备 sysfs 目录（findDevice 的返回值）
+     * @param channels 需要的通道名（不含 _en 后缀，如 "in_accel_x"）；
+     *                 设备存在 in_timestamp 时自动启用
+     * @param bufferLength 内核缓冲区可容纳的 scan 数
+     * @param devRoot 字符设备目录
+     * @return 全部通道可用且缓冲区启用成功返回true
+     */
+    bool open(const QString &deviceDir, const QStringList &channels,
+              int bufferLength = 128, const QString &devRoot = "/dev");
+
+    /**
+     * @brief 关闭字符设备并停用缓冲区
+     */
+    void close();
+
+    bool isOpen() const { return m_fd >= 0; }
+    int fd() const { return m_fd; }                ///< 字符设备 fd，用于 poll()
+    int scanSize() const { return m_scanSize; }    ///< 每个 scan 的字节数
+    QString errorString() const { return m_error; }
+
+    /**
+     * @brief 读取若干完整 scan（非阻塞）
+     * @param buf 输出缓冲区，大小至少为 scanSize()
+     * @return 读取到的 scan 数，无数据返回 0，出错返回 -1
+     */
+    int read(uint8_t *buf, int size);
+
+    int channelCount() const { return m_channels.size(); }
+    int channelIndex(const QString &name) const;    ///< open() 时传入的顺序，不存在返回 -1
+    const Channel &channel(int i) const { return m_channels.at(i); }
+
+    int64_t raw(const uint8_t *scan, int channel) const;        ///< 原始值（已处理字节序、移位与符号）
+    double value(const uint8_t *scan, int channel) const;       ///< 换算后的物理量
+    bool hasTimestamp() const { return m_timestamp.storageBytes > 0; }
+    int64_t timestampNs(const uint8_t *scan) const;             ///< scan 的内核时间戳（纳秒）
+
+    static QByteArray readAttr(const QString &path);                    ///< 读取 sysfs 属性（去除首尾空白）
+    static bool writeAttr(const QString &path, const QByteArray &value); ///< 写入 sysfs 属性
+
+private:
+    bool setupChannel(const QString &name, Channel &channel);
+    bool enableChannel(const QString &name, bool enable);
+    bool selectTrigger();
+    int64_t decode(const uint8_t *scan, const Channel &channel) const;
+
+    static bool parseType(const QByteArray &type, Channel &channel);
+
+    QString m_deviceDir;
+    QVector<Channel> m_channels;  ///< 与 open() 传入顺序一致
+    Channel m_timestamp;          ///< 时间戳通道（storageBytes=0 表示没有）
+    int m_scanSize = 0;
+    int m_fd = -1;
+    QString m_error;
+};
+
+#endif // IIOBUFFERREADER_H
@@ -0,0 +1,170 @@
+#include "imagecache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+struct Mapping {
+    void *address;
+    size_t size;
+};
+
+void unmapImage(void *info)
+{
+    Mapping *mapping = static_cast<Mapping *>(info);
+    munmap(mapping->address, mapping->size);
+    delete mapping;
+}
+
+} // namespace
+
+ImageCache::ImageCache(const QString &dir, qint64 maxBytes)
+    : m_dir(dir),
+      m_maxBytes(maxBytes)
+{
+    if (m_dir.isEmpty()) {
+        const QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        if (!base.isEmpty())
+            m_dir = base + "/album";
+    }
+
+    if (!m_dir.isEmpty() && !QDir().mkpath(m_dir)) {
+        qDebug() << "ImageCache: cannot create" << m_dir;
+        m_dir.clear();
+    }
+}
+
+QByteArray ImageCache::key(const QString &path, const QSize &targetSize)
+{
+    const QFileInfo info(path);
+    if (!info.exists())
+        return QByteArray();
+
+    QByteArray text = info.absoluteFilePath().toUtf8();
+    text += '\n' + QByteArray::number(info.lastModified().toMSecsSinceEpoch());
+    text += '\n' + QByteArray::number(info.size());
+    text += '\n' + QByteArray::number(targetSize.width()) + 'x' + QByteArray::number(targetSize.height());
+    return QCryptographicHash::hash(text, QCryptographicHash::Sha1).toHex();
+}
+
+QString ImageCache::filePath(const QByteArray &key) const
+{
+    return m_dir + '/' + QString::fromLatin1(key) + ".img";
+}
+
+QImage ImageCache::load(const QByteArray &key) const
+{
+    if (m_dir.isEmpty() || key.isEmpty())
+        return QImage();
+
+    const QByteArray path = QFile::encodeName(filePath(key));
+    const int fd = ::open(path.constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return QImage();
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(ImageCacheHeader))) {
+        ::close(fd);
+        return QImage();
+    }
+
+    const size_t size = static_cast<size_t>(st.st_size);
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        ::close(fd);
+        return QImage();
+    }
+
+    ImageCacheHeader header;
+    memcpy(&header, map, sizeof(header));
+
+    const QImage::Format format = static_cast<QImage::Format>(header.format);
+    const bool valid = header.magic == IMAGE_CACHE_MAGIC &&
+            header.version == IMAGE_CACHE_VERSION &&
+            (format == QImage::Format_RGB32 || format == QImage::Format_ARGB32_Premultiplied) &&
+            header.width > 0 && header.height > 0 &&
+            header.bytesPerLine >= header.width * 4 && header.bytesPerLine % 4 == 0 &&
+            header.dataOffset >= sizeof(ImageCacheHeader) && header.dataOffset % 4 == 0 &&
+            static_cast<quint64>(header.dataOffset) +
+            static_cast<quint64>(header.bytesPerLine) * header.height <= size;
+    if (!valid) {
+        qDebug() << "ImageCache: invalid cache file" << path;
+        munmap(map, size);
+        ::close(fd);
+        return QImage();
+    }
+
+    // 命中时更新修改时间，prune() 按修改时间淘汰即为最近最少使用
+    futimens(fd, nullptr);
+    ::close(fd);
+
+    // 像素在被访问时才从页缓存换入，大部分情况下这就是整个“加载”过程
+    madvise(map, size, MADV_WILLNEED);
+
+    const uchar *pixels = static_cast<const uchar *>(map) + header.dataOffset;
+    return QImage(pixels, header.width, header.height, header.bytesPerLine, format,
+                  unmapImage, new Mapping{ map, size });
+}
+
+bool ImageCache::store(const QByteArray &key, const QImage &image) const
+{
+    if (m_dir.isEmpty() || key.isEmpty() || image.isNull())
+        return false;
+    if (image.format() != QImage::Format_RGB32 && image.format() != QImage::Format_ARGB32_Premultiplied)
+        return false;
+
+    ImageCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = IMAGE_CACHE_MAGIC;
+    header.version = IMAGE_CACHE_VERSION;
+    header.width = image.width();
+    header.height = image.height();
+    header.bytesPerLine = image.bytesPerLine();
+    header.format = image.format();
+    header.dataOffset = sizeof(ImageCacheHeader);
+
+    // QSaveFile 写入同目录下的临时文件，commit() 时改名
+    QSaveFile file(filePath(key));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    const qint64 dataBytes = static_cast<qint64>(image.bytesPerLine()) * image.height();
+    if (file.write(reinterpret_cast<const char *>(&header), sizeof(header)) != qint64(sizeof(header)) ||
+        file.write(reinterpret_cast<const char *>(image.constBits()), dataBytes) != dataBytes) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+void ImageCache::prune() const
+{
+    if (m_dir.isEmpty() || m_maxBytes <= 0)
+        return;
+
+    QDir dir(m_dir);
+    const QFileInfoList files = dir.entryInfoList(QStringList() << "*.img", QDir::Files, QDir::Time);
+
+    // 按修改时间（写入或最近一次命中）从新到旧累加，超出部分删除
+    qint64 total = 0;
+    int removed = 0;
+    for (const QFileInfo &info : files) {
+        total += info.size();
+        if (total > m_maxBytes && dir.remove(info.fileName()))
+            removed++;
+    }
+    if (removed > 0)
+        qDebug() << "ImageCache: pruned" << removed << "files";
+}
@@ -0,0 +1,88 @@
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <QImage>
+#include <QSize>
+#include <QString>
+
+#include <cstdint>
+
+/*
+ * 图片缓存文件格式（小端）
+ *
+ *   <缓存目录>/<键的 SHA-1>.img
+ *   文件 : ImageCacheHeader（64 字节） + height 行像素，每行 bytesPerLine 字节
+ *
+ * 键由源文件路径、修改时间、文件大小和目标尺寸组成，源文件变化后键随之变化，
+ * 旧文件不再命中。load() 命中时更新文件修改时间，prune() 按修改时间淘汰最近最少使用的文件。
+ * 像素为 QImage 的 RGB32 / ARGB32_Premultiplied，读取时 mmap 后直接构造 QImage，
+ * 不解码、不拷贝、不转换格式。
+ */
+
+#define IMAGE_CACHE_MAGIC   0x43474D49u   // "IMGC"
+#define IMAGE_CACHE_VERSION 1
+
+#pragma pack(push, 1)
+struct ImageCacheHeader {
+    uint32_t magic;          ///< IMAGE_CACHE_MAGIC
+    uint32_t version;        ///< IMAGE_CACHE_VERSION
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytesPerLine;
+    uint32_t format;         ///< QImage::Format
+    uint32_t dataOffset;     ///< 像素数据在文件中的偏移
+    uint8_t reserved[36];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(ImageCacheHeader) == 64, "ImageCacheHeader 必须为 64 字节");
+
+/**
+ * @brief 按内容寻址的预缩放图片磁盘缓存
+ *
+ * load()/store() 没有共享的可变状态，可在多个解码线程中同时调用；
+ * store() 先写临时文件再改名，读取方不会看到半写的文件。
+ */
+class ImageCache
+{
+public:
+    /**
+     * @param dir 缓存目录，为空时使用 QStandardPaths::CacheLocation 下的 album 目录
+     * @param maxBytes prune() 保留的总大小
+     */
+    explicit ImageCache(const QString &dir = QString(), qint64 maxBytes = 256 * 1024 * 1024);
+
+    QString directory() const { return m_dir; }
+    bool isValid() const { return !m_dir.isEmpty(); }
+
+    /**
+     * @brief 缓存键（源文件不存在时为空）
+     */
+    static QByteArray key(const QString &path, const QSize &targetSize);
+
+    /**
+     * @brief 读取缓存，未命中或文件损坏时返回空图片
+     *
+     * 返回的 QImage 直接引用只读映射，最后一个副本释放时解除映射；
+     * 修改图片时 QImage 会先拷贝一份。
+     */
+    QImage load(const QByteArray &key) const;
+
+    /**
+     * @brief 写入缓存，只接受 RGB32 / ARGB32_Premultiplied
+     */
+    bool store(const QByteArray &key, const QImage &image) const;
+
+    /**
+     * @brief 总大小超过 maxBytes 时按修改时间（最近一次写入或命中）删除最久未用的文件
+     */
+    void prune() const;
+
+private:
+    QString filePath(const QByteArray &key) const;
+
+    QString m_dir;
+    qint64 m_maxBytes;
+};
+
+#endif // IMAGECACHE_H
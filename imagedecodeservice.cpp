@@ -0,0 +1,162 @@
+#include "imagedecodeservice.h"
+#include "imagecache.h"
+
+#include <QDebug>
+#include <QImageReader>
+#include <QRunnable>
+#include <QThread>
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+class DecodeTask : public QRunnable
+{
+public:
+    DecodeTask(ImageDecodeService *service, quint64 id, const QString &path, const QSize &targetSize,
+               const ImageCache *cache, const QSharedPointer<QAtomicInt> &cancelled)
+        : m_service(service), m_id(id), m_path(path), m_targetSize(targetSize),
+          m_cache(cache), m_cancelled(cancelled)
+    {
+    }
+
+    void run() override
+    {
+        // 线程池线程为 SCHED_OTHER，QThread::setPriority 不起作用，直接设置线程的 nice 值
+        static thread_local bool niced = false;
+        if (!niced) {
+            setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+            niced = true;
+        }
+
+        if (m_cancelled->loadAcquire())
+            return;
+
+        const QImage image = ImageDecodeService::decode(m_path, m_targetSize, m_cache);
+
+        // 解码期间被取消的结果不再投递
+        if (m_cancelled->loadAcquire())
+            return;
+        QMetaObject::invokeMethod(m_service, "onTaskDone", Qt::QueuedConnection,
+                                  Q_ARG(quint64, m_id), Q_ARG(QImage, image));
+    }
+
+private:
+    ImageDecodeService *m_service;
+    quint64 m_id;
+    QString m_path;
+    QSize m_targetSize;
+    const ImageCache *m_cache;
+    QSharedPointer<QAtomicInt> m_cancelled;
+};
+
+/**
+ * @brief 解码并缩放到目标尺寸内
+ */
+QImage readImage(const QString &path, const QSize &targetSize)
+{
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+
+    // size()/setScaledSize() 针对旋转前的原始图像，EXIF 旋转 90° 时宽高互换
+    const bool transposed = reader.transformation() & QImageIOHandler::TransformationRotate90;
+    const QSize rawSize = reader.size();
+    const QSize sourceSize = transposed ? rawSize.transposed() : rawSize;
+    QSize scaledSize;
+    if (targetSize.isValid() && sourceSize.isValid() &&
+        (sourceSize.width() > targetSize.width() || sourceSize.height() > targetSize.height())) {
+        scaledSize = sourceSize.scaled(targetSize, Qt::KeepAspectRatio);
+        if (reader.supportsOption(QImageIOHandler::ScaledSize))
+            reader.setScaledSize(transposed ? scaledSize.transposed() : scaledSize);
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qDebug() << "ImageDecodeService:" << path << reader.errorString();
+        return QImage();
+    }
+
+    // 解码器不支持缩放或尺寸有出入时按比例缩到目标范围内，不拉伸
+    if (scaledSize.isValid() && image.size() != scaledSize)
+        image = image.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    const QImage::Format format = image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                          : QImage::Format_RGB32;
+    if (image.format() != format)
+        image = image.convertToFormat(format);
+    return image;
+}
+
+} // namespace
+
+ImageDecodeService::ImageDecodeService(int maxThreads, QObject *parent)
+    : QObject(parent)
+{
+    if (maxThreads <= 0)
+        maxThreads = qBound(1, QThread::idealThreadCount(), 2);
+    m_pool.setMaxThreadCount(maxThreads);
+    // 翻页间隔内保持线程，避免反复创建
+    m_pool.setExpiryTimeout(5000);
+}
+
+ImageDecodeService::~ImageDecodeService()
+{
+    cancelAll();
+    m_pool.waitForDone();
+}
+
+QImage ImageDecodeService::decode(const QString &path, const QSize &targetSize, const ImageCache *cache)
+{
+    const QByteArray key = cache ? ImageCache::key(path, targetSize) : QByteArray();
+    if (!key.isEmpty()) {
+        const QImage cached = cache->load(key);
+        if (!cached.isNull())
+            return cached;
+    }
+
+    const QImage image = readImage(path, targetSize);
+    if (!key.isEmpty() && !image.isNull() && !cache->store(key, image))
+        qDebug() << "ImageDecodeService: cannot cache" << path;
+    return image;
+}
+
+quint64 ImageDecodeService::request(const QString &path, const QSize &targetSize, int priority)
+{
+    const quint64 id = m_nextId++;
+    QSharedPointer<QAtomicInt> cancelled(new QAtomicInt(0));
+    m_pending.insert(id, cancelled);
+    m_paths.insert(id, path);
+
+    m_pool.start(new DecodeTask(this, id, path, targetSize, m_cache, cancelled), priority);
+    return id;
+}
+
+void ImageDecodeService::cancel(quint64 id)
+{
+    const QSharedPointer<QAtomicInt> cancelled = m_pending.take(id);
+    if (cancelled)
+        cancelled->storeRelease(1);
+    m_paths.remove(id);
+}
+
+void ImageDecodeService::cancelAll()
+{
+    for (const QSharedPointer<QAtomicInt> &cancelled : qAsConst(m_pending))
+        cancelled->storeRelease(1);
+    m_pending.clear();
+    m_paths.clear();
+    // 丢弃尚未开始的任务
+    m_pool.clear();
+}
+
+/**
+ * @brief 工作线程的结果（已排队到本线程），已取消的请求不会出现在 m_pending 中
+ */
+void ImageDecodeService::onTaskDone(quint64 id, const QImage &image)
+{
+    if (!m_pending.remove(id))
+        return;
+    emit decoded(id, m_paths.take(id), image);
+}
@@ -0,0 +1,83 @@
+#ifndef IMAGEDECODESERVICE_H
+#define IMAGEDECODESERVICE_H
+
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QSharedPointer>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+
+class ImageCache;
+
+/**
+ * @brief 后台图片解码/缩放服务
+ *
+ * 请求在独立的小线程池中执行（不占用全局线程池），工作线程：
+ * - 用 QImageReader::setScaledSize 让支持的格式在解码时直接缩小（JPEG 在 DCT 域缩放，
+ *   只解码需要的分辨率）；不支持的格式（PNG 等）解码后再平滑缩放
+ * - 输出 RGB32 / ARGB32_Premultiplied，GUI线程转换为 QPixmap 时不需要再转换格式
+ * - 以较低的调度优先级（nice）运行，单核板子上解码不会抢占界面绘制
+ * - 设置了 ImageCache 时先查缓存，命中时直接映射缓存文件，不解码；未命中时解码后写入缓存
+ *
+ * 结果通过 decoded() 在服务所在线程（GUI线程）发射。cancel() 之后该请求不会再有结果：
+ * 尚未开始的任务直接跳过，正在解码的任务结果被丢弃。
+ * 只能在服务所在的线程中调用。
+ */
+class ImageDecodeService : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param maxThreads 解码线程数，<= 0 时按 CPU 核数选择（最多 2 个）
+     */
+    explicit ImageDecodeService(int maxThreads = 0, QObject *parent = nullptr);
+    ~ImageDecodeService();
+
+    /**
+     * @brief 请求解码
+     * @param targetSize 目标尺寸（保持宽高比缩放到其内），无效时保持原尺寸
+     * @param priority 数值越大越先执行
+     * @return 请求号（非 0）
+     */
+    quint64 request(const QString &path, const QSize &targetSize, int priority = 0);
+
+    /**
+     * @brief 取消请求（未知或已完成的请求号忽略）
+     */
+    void cancel(quint64 id);
+    void cancelAll();
+
+    int pendingCount() const { return m_pending.count(); }
+
+    /**
+     * @brief 设置磁盘缓存（由调用者管理生命周期），应在第一次 request 之前设置
+     */
+    void setCache(const ImageCache *cache) { m_cache = cache; }
+
+    /**
+     * @brief 在调用线程中同步解码，规则与后台任务相同
+     * @param cache 为空时不使用缓存
+     */
+    static QImage decode(const QString &path, const QSize &targetSize, const ImageCache *cache = nullptr);
+
+signals:
+    /**
+     * @brief 解码完成，失败时 image 为空
+     */
+    void decoded(quint64 id, const QString &path, const QImage &image);
+
+private slots:
+    void onTaskDone(quint64 id, const QImage &image);
+
+private:
+    QThreadPool m_pool;
+    const ImageCache *m_cache = nullptr;
+    quint64 m_nextId = 1;
+    QHash<quint64, QSharedPointer<QAtomicInt>> m_pending;  ///< 请求号 -> 取消标志
+    QHash<quint64, QString> m_paths;
+};
+
+#endif // IMAGEDECODESERVICE_H
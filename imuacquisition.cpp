@@ -0,0 +1,487 @@
+#include "imuacquisition.h"
+#include "iiobufferreader.h"
+#include "sysfsfilecache.h"
+
+#include <QDebug>
+#include <QFile>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <sys/timerfd.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+// IIO 标准单位（m/s²、rad/s）换算为界面使用的 g、°/s
+static const float kStandardGravity = 9.80665f;
+static const float kRadToDeg = 57.2957795f;
+
+// 模拟数据源记录：6 个 float32
+static const int kFakeRecordSize = 6 * sizeof(float);
+
+ImuAcquisition::ImuAcquisition(QObject *parent)
+    : QThread(parent),
+      m_backend(NoBackend)
+{
+    setObjectName("imu-acq");
+    m_stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+}
+
+ImuAcquisition::~ImuAcquisition()
+{
+    stopAcquisition();
+    if (m_stopFd >= 0)
+        ::close(m_stopFd);
+}
+
+void ImuAcquisition::setSampleRate(int hz)
+{
+    m_rateHz = qBound(100, hz, 1000);
+}
+
+void ImuAcquisition::setBatchInterval(int ms)
+{
+    m_batchIntervalMs = qBound(1, ms, 1000);
+}
+
+void ImuAcquisition::startAcquisition()
+{
+    if (isRunning()) return;
+
+    // 清除上一次残留的停止请求
+    uint64_t value;
+    while (::read(m_stopFd, &value, sizeof(value)) > 0) {}
+
+    start(QThread::HighPriority);
+}
+
+void ImuAcquisition::stopAcquisition()
+{
+    if (!isRunning()) return;
+
+    const uint64_t one = 1;
+    if (::write(m_stopFd, &one, sizeof(one)) < 0)
+        qDebug() << "ImuAcquisition: eventfd write failed" << strerror(errno);
+    wait();
+}
+
+qint64 ImuAcquisition::monotonicUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief 创建按采样率周期触发的 timerfd
+ * @return fd，失败返回 -1
+ */
+int ImuAcquisition::openTimer() const
+{
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (fd < 0)
+        return -1;
+
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = 0;
+    spec.it_interval.tv_nsec = 1000000000L / m_rateHz;
+    spec.it_value = spec.it_interval;
+    if (timerfd_settime(fd, 0, &spec, nullptr) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief 同时等待停止请求和 fd
+ * @param ready fd 就绪时置为 true
+ * @return 收到停止请求或 poll 出错返回 false
+ */
+bool ImuAcquisition::waitStopOr(int fd, short events, int timeoutMs, bool &ready)
+{
+    struct pollfd fds[2];
+    fds[0].fd = m_stopFd;
+    fds[0].events = POLLIN;
+    fds[1].fd = fd;
+    fds[1].events = events;
+
+    int n;
+    do {
+        n = poll(fds, 2, timeoutMs);
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0) {
+        emit acquisitionError(QString("poll 失败: %1").arg(strerror(errno)));
+        return false;
+    }
+    if (fds[0].revents)
+        return false;
+
+    ready = fds[1].revents != 0;
+    return true;
+}
+
+void ImuAcquisition::append(const Sensor6AxisData &sample)
+{
+    m_batch.append(sample);
+    flush(false);
+}
+
+/**
+ * @brief 到达批量间隔（或 force）时发送当前批次
+ */
+void ImuAcquisition::flush(bool force)
+{
+    if (m_batch.isEmpty())
+        return;
+
+    const qint64 now = monotonicUs();
+    if (!force && now - m_lastFlushUs < static_cast<qint64>(m_batchIntervalMs) * 1000)
+        return;
+
+    if (m_filterEnabled)
+        filterBatch();
+
+    emit samplesReady(m_batch);
+    m_lastFlushUs = now;
+
+    // 已发送的批次被接收方共享，重新分配而不是原地清空
+    m_batch = Sensor6AxisBatch();
+    m_batch.reserve(m_rateHz * m_batchIntervalMs / 1000 + 8);
+}
+
+/**
+ * @brief 整批转为数组结构体滤波，只写回姿态
+ *
+ * ax..gz 保持传感器测量值：高通只用于姿态融合，界面与日志看到的仍是实际角速度。
+ */
+void ImuAcquisition::filterBatch()
+{
+    const int n = m_batch.size();
+    m_soa.resize(n);
+
+    Sensor6AxisData *samples = m_batch.data();
+    float *ax = m_soa.axis[IMU_AX].data();
+    float *ay = m_soa.axis[IMU_AY].data();
+    float *az = m_soa.axis[IMU_AZ].data();
+    float *gx = m_soa.axis[IMU_GX].data();
+    float *gy = m_soa.axis[IMU_GY].data();
+    float *gz = m_soa.axis[IMU_GZ].data();
+    for (int i = 0; i < n; ++i) {
+        ax[i] = samples[i].ax;
+        ay[i] = samples[i].ay;
+        az[i] = samples[i].az;
+        gx[i] = samples[i].gx;
+        gy[i] = samples[i].gy;
+        gz[i] = samples[i].gz;
+    }
+
+    m_filter.process(m_soa);
+
+    for (int i = 0; i < n; ++i) {
+        samples[i].roll = m_soa.roll[i];
+        samples[i].pitch = m_soa.pitch[i];
+    }
+}
+
+void ImuAcquisition::run()
+{
+    m_batch = Sensor6AxisBatch();
+    m_batch.reserve(m_rateHz * m_batchIntervalMs / 1000 + 8);
+    m_lastFlushUs = monotonicUs();
+
+    ImuFilter::Config config = m_filterConfig;
+    config.sampleRateHz = m_rateHz;
+    m_filter.configure(config);
+    m_soa.resize(m_batch.capacity());
+
+    if (!m_fakePath.isEmpty()) {
+        m_backend.store(FakeStream, std::memory_order_relaxed);
+        runFake();
+    } else {
+        const QString device = m_iioName.isEmpty() ? QString() : IioBufferReader::findDevice(m_iioName, m_iioDevicesDir);
+        if (device.isEmpty()) {
+            emit acquisitionError(QString("未找到六轴传感器 IIO 设备 %1").arg(m_iioName));
+        } else {
+            m_backend.store(IioBuffer, std::memory_order_relaxed);
+            if (!runIio(device)) {
+                m_backend.store(SysfsPoll, std::memory_order_relaxed);
+                runSysfs(device);
+            }
+        }
+    }
+
+    flush(true);
+    m_backend.store(NoBackend, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 模拟数据源：普通文件按采样率循环回放，pty/FIFO 数据到达即读取
+ */
+void ImuAcquisition::runFake()
+{
+    const QByteArray path = QFile::encodeName(m_fakePath);
+    int fd = ::open(path.constData(), O_RDONLY | O_NONBLOCK | O_CLOEXEC | O_NOCTTY);
+    if (fd < 0) {
+        emit acquisitionError(QString("无法打开模拟数据源 %1: %2").arg(m_fakePath).arg(strerror(errno)));
+        return;
+    }
+
+    struct stat st;
+    const bool replay = fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+    if (replay && st.st_size < kFakeRecordSize) {
+        emit acquisitionError(QString("模拟数据源 %1 为空").arg(m_fakePath));
+        ::close(fd);
+        return;
+    }
+
+    if (isatty(fd)) {
+        // pty 默认行缓冲并转换换行符，二进制记录需要原始模式
+        struct termios tio;
+        if (tcgetattr(fd, &tio) == 0) {
+            cfmakeraw(&tio);
+            tcsetattr(fd, TCSANOW, &tio);
+        }
+    }
+
+    const int timerFd = replay ? openTimer() : -1;
+    if (replay && timerFd < 0) {
+        emit acquisitionError(QString("timerfd 创建失败: %1").arg(strerror(errno)));
+        ::close(fd);
+        return;
+    }
+
+    char buf[kFakeRecordSize * 64];
+    int pending = 0;   // buf 中未凑满一条记录的字节数
+
+    for (;;) {
+        bool ready = false;
+        if (!waitStopOr(replay ? timerFd : fd, POLLIN, m_batchIntervalMs, ready))
+            break;
+        if (!ready) {
+            flush(false);
+            continue;
+        }
+
+        int records = 1;
+        if (replay) {
+            // 每次到期回放一条；处理不及时的到期次数一并补上
+            uint64_t expirations = 0;
+            if (::read(timerFd, &expirations, sizeof(expirations)) != sizeof(expirations))
+                continue;
+            records = static_cast<int>(qMin<uint64_t>(expirations, sizeof(buf) / kFakeRecordSize));
+        }
+
+        ssize_t n = ::read(fd, buf + pending, replay ? records * kFakeRecordSize - pending
+                                                     : sizeof(buf) - pending);
+        if (n == 0 && replay) {
+            // 回到文件开头，丢弃文件末尾不完整的记录
+            lseek(fd, 0, SEEK_SET);
+            pending = 0;
+            continue;
+        }
+        if (n <= 0) {
+            if (n < 0 && (errno == EAGAIN || errno == EINTR))
+                continue;
+            if (n == 0) {
+                // FIFO 写端关闭或 pty 挂断
+                emit acquisitionError(QString("模拟数据源 %1 已关闭").arg(m_fakePath));
+            } else {
+                emit acquisitionError(QString("读取模拟数据源失败: %1").arg(strerror(errno)));
+            }
+            break;
+        }
+
+        pending += static_cast<int>(n);
+        const int complete = pending / kFakeRecordSize;
+        const qint64 now = monotonicUs();
+        const qint64 periodUs = 1000000 / m_rateHz;
+
+        for (int i = 0; i < complete; ++i) {
+            float values[6];
+            memcpy(values, buf + i * kFakeRecordSize, sizeof(values));
+
+            Sensor6AxisData sample;
+            sample.ax = values[0];
+            sample.ay = values[1];
+            sample.az = values[2];
+            sample.gx = values[3];
+            sample.gy = values[4];
+            sample.gz = values[5];
+            // 一次读到多条时按采样周期向前推算
+            sample.timestampUs = now - (complete - 1 - i) * periodUs;
+            append(sample);
+        }
+
+        pending -= complete * kFakeRecordSize;
+        memmove(buf, buf + complete * kFakeRecordSize, pending);
+    }
+
+    if (timerFd >= 0)
+        ::close(timerFd);
+    ::close(fd);
+}
+
+/**
+ * @brief IIO 缓冲模式：设置水位使每批数据只唤醒一次
+ * @return 缓冲模式不可用返回false（由调用者回退到 sysfs）
+ */
+bool ImuAcquisition::runIio(const QString &deviceDir)
+{
+    static const char *const channels[6] = {
+        "in_accel_x", "in_accel_y", "in_accel_z",
+        "in_anglvel_x", "in_anglvel_y", "in_anglvel_z"
+    };
+    QStringList names;
+    for (const char *name : channels)
+        names << name;
+
+    // 采样率：有的驱动是共享属性，有的按传感器类型分开
+    const QByteArray rate = QByteArray::number(m_rateHz);
+    if (!IioBufferReader::writeAttr(deviceDir + "/sampling_frequency", rate)) {
+        IioBufferReader::writeAttr(deviceDir + "/in_accel_sampling_frequency", rate);
+        IioBufferReader::writeAttr(deviceDir + "/in_anglvel_sampling_frequency", rate);
+    }
+
+    // 时间戳默认是 CLOCK_REALTIME，切换为单调时钟与其他传感器一致
+    const bool monotonicStamps = IioBufferReader::writeAttr(deviceDir + "/current_timestamp_clock", "monotonic\n");
+
+    // 缓冲区容纳约 0.5 s 数据，积累一个批次再唤醒
+    const int length = qMax(64, m_rateHz / 2);
+    const int watermark = qBound(1, m_rateHz * m_batchIntervalMs / 1000, length / 2);
+    IioBufferReader::writeAttr(deviceDir + "/buffer/enable", "0");
+    IioBufferReader::writeAttr(deviceDir + "/buffer/length", QByteArray::number(length));
+    IioBufferReader::writeAttr(deviceDir + "/buffer/watermark", QByteArray::number(watermark));
+
+    IioBufferReader reader;
+    if (!reader.open(deviceDir, names, length, m_iioDevDir)) {
+        qDebug() << "六轴 IIO 缓冲模式不可用:" << reader.errorString();
+        return false;
+    }
+
+    QVector<uint8_t> buf(reader.scanSize() * 64);
+    const qint64 periodUs = 1000000 / m_rateHz;
+
+    for (;;) {
+        bool ready = false;
+        if (!waitStopOr(reader.fd(), POLLIN, m_batchIntervalMs * 2, ready))
+            break;
+        if (!ready) {
+            flush(false);
+            continue;
+        }
+
+        // 一次唤醒把内核缓冲区读空
+        int scans;
+        while ((scans = reader.read(buf.data(), buf.size())) > 0) {
+            const qint64 now = monotonicUs();
+            for (int i = 0; i < scans; ++i) {
+                const uint8_t *scan = buf.constData() + i * reader.scanSize();
+
+                Sensor6AxisData sample;
+                sample.ax = static_cast<float>(reader.value(scan, 0)) / kStandardGravity;
+                sample.ay = static_cast<float>(reader.value(scan, 1)) / kStandardGravity;
+                sample.az = static_cast<float>(reader.value(scan, 2)) / kStandardGravity;
+                sample.gx = static_cast<float>(reader.value(scan, 3)) * kRadToDeg;
+                sample.gy = static_cast<float>(reader.value(scan, 4)) * kRadToDeg;
+                sample.gz = static_cast<float>(reader.value(scan, 5)) * kRadToDeg;
+                if (reader.hasTimestamp() && monotonicStamps)
+                    sample.timestampUs = reader.timestampNs(scan) / 1000;
+                else
+                    sample.timestampUs = now - (scans - 1 - i) * periodUs;
+                m_batch.append(sample);
+            }
+            if (scans * reader.scanSize() < buf.size())
+                break;   // 已读空
+        }
+        if (scans < 0) {
+            emit acquisitionError(QString("读取 IIO 缓冲区失败: %1").arg(strerror(errno)));
+            break;
+        }
+        flush(false);
+    }
+    return true;
+}
+
+/**
+ * @brief 读取通道比例系数：优先通道专用的 in_accel_x_scale，其次共享的 in_accel_scale
+ */
+static double channelScale(const QString &deviceDir, const QString &type, const QString &axis)
+{
+    bool ok = false;
+    double scale = IioBufferReader::readAttr(deviceDir + "/" + type + "_" + axis + "_scale").toDouble(&ok);
+    if (!ok)
+        scale = IioBufferReader::readAttr(deviceDir + "/" + type + "_scale").toDouble(&ok);
+    return ok ? scale : 1.0;
+}
+
+/**
+ * @brief sysfs 后端：timerfd 按采样率触发，每次读取 6 个 raw 属性
+ */
+void ImuAcquisition::runSysfs(const QString &deviceDir)
+{
+    static const char *const axes[3] = { "x", "y", "z" };
+
+    SysfsFileCache files;
+    int slots[6];
+    float factors[6];
+    for (int i = 0; i < 6; ++i) {
+        const QString type = i < 3 ? "in_accel" : "in_anglvel";
+        const QString axis = axes[i % 3];
+        slots[i] = files.add(deviceDir + "/" + type + "_" + axis + "_raw", SysfsFileCache::Read);
+        const double unit = i < 3 ? 1.0 / kStandardGravity : kRadToDeg;
+        factors[i] = static_cast<float>(channelScale(deviceDir, type, axis) * unit);
+    }
+
+    IioBufferReader::writeAttr(deviceDir + "/sampling_frequency", QByteArray::number(m_rateHz));
+
+    const int timerFd = openTimer();
+    if (timerFd < 0) {
+        emit acquisitionError(QString("timerfd 创建失败: %1").arg(strerror(errno)));
+        return;
+    }
+
+    bool reportedError = false;
+    for (;;) {
+        bool ready = false;
+        if (!waitStopOr(timerFd, POLLIN, -1, ready))
+            break;
+
+        uint64_t expirations;
+        if (::read(timerFd, &expirations, sizeof(expirations)) != sizeof(expirations))
+            continue;
+
+        // 读取跟不上采样率时丢弃错过的周期，只读取一次当前值
+        Sensor6AxisData sample;
+        sample.timestampUs = monotonicUs();
+        qint32 raw[6];
+        bool ok = true;
+        for (int i = 0; i < 6 && ok; ++i)
+            ok = files.readInt32(slots[i], raw[i]);
+
+        if (!ok) {
+            if (!reportedError) {
+                emit acquisitionError(QString("读取六轴传感器失败"));
+                reportedError = true;
+            }
+            continue;
+        }
+        reportedError = false;
+
+        sample.ax = raw[0] * factors[0];
+        sample.ay = raw[1] * factors[1];
+        sample.az = raw[2] * factors[2];
+        sample.gx = raw[3] * factors[3];
+        sample.gy = raw[4] * factors[4];
+        sample.gz = raw[5] * factors[5];
+        append(sample);
+    }
+
+    ::close(timerFd);
+}
@@ -0,0 +1,123 @@
+#ifndef IMUACQUISITION_H
+#define IMUACQUISITION_H
+
+#include <QThread>
+#include <QString>
+#include <atomic>
+
+#include "smartdevicemodule.h"
+#include "imufilter.h"
+
+class IioBufferReader;
+
+/**
+ * @brief 六轴（加速度计 + 陀螺仪）采集线程
+ *
+ * 按以下顺序选择后端：
+ * 1. 模拟数据源：setFakeSource() 设置了路径时使用，用于测试
+ *    - 普通文件：按采样率循环回放
+ *    - pty/FIFO：数据到达即读取，以到达时间作为时间戳
+ *    记录格式为 6 个小端 float32（ax ay az 单位 g，gx gy gz 单位 °/s），共 24 字节
+ * 2. IIO 缓冲模式：找到同名 IIO 设备时，poll() 字符设备 /dev/iio:deviceN，按水位批量读取
+ * 3. sysfs：同一 IIO 设备的 in_accel_x_raw 等属性，timerfd 按采样率定时读取
+ *
+ * 采样率 100~1000 Hz。样本在采集线程中攒批，每 batchInterval 毫秒发射一次 samplesReady，
+ * 界面不必为每个样本排队一次事件。启用滤波时，发射前在采集线程中对整批数据
+ * 执行 ImuFilter（低通、陀螺仪高通、互补融合姿态），只填入 roll/pitch，ax..gz 保持原始值。线程中使用 poll() 阻塞，停止时通过 eventfd 唤醒。
+ * 配置接口只应在采集停止时调用。
+ */
+class ImuAcquisition : public QThread
+{
+    Q_OBJECT
+
+public:
+    enum Backend {
+        NoBackend,   ///< 未运行
+        FakeStream,  ///< 模拟数据源（文件/pty）
+        IioBuffer,   ///< IIO 缓冲模式
+        SysfsPoll    ///< sysfs 定时读取
+    };
+
+    explicit ImuAcquisition(QObject *parent = nullptr);
+    ~ImuAcquisition();
+
+    /**
+     * @brief 设置 IIO 设备名，为空时不尝试 IIO 设备
+     */
+    void setIioDeviceName(const QString &name) { m_iioName = name; }
+
+    /**
+     * @brief 设置 IIO 设备目录与字符设备目录（默认为真实设备，测试时指向模拟目录树）
+     */
+    void setIioPaths(const QString &devicesDir, const QString &devDir)
+    {
+        m_iioDevicesDir = devicesDir;
+        m_iioDevDir = devDir;
+    }
+
+    /**
+     * @brief 设置模拟数据源（文件或 pty 路径），为空时使用真实设备
+     */
+    void setFakeSource(const QString &path) { m_fakePath = path; }
+
+    /**
+     * @brief 设置采样率（Hz），限制在 100~1000
+     */
+    void setSampleRate(int hz);
+    int sampleRate() const { return m_rateHz; }
+
+    /**
+     * @brief 设置批量发送间隔（毫秒）
+     */
+    void setBatchInterval(int ms);
+
+    /**
+     * @brief 滤波级设置，采样率由 setSampleRate() 决定
+     */
+    void setFilterEnabled(bool enabled) { m_filterEnabled = enabled; }
+    void setFilterConfig(const ImuFilter::Config &config) { m_filterConfig = config; }
+
+    void startAcquisition();    ///< 启动采集线程
+    void stopAcquisition();     ///< 唤醒并等待采集线程退出
+
+    Backend backend() const { return m_backend.load(std::memory_order_relaxed); }
+
+signals:
+    void samplesReady(const Sensor6AxisBatch &batch);
+    void acquisitionError(const QString &errorMsg);
+
+protected:
+    void run() override;
+
+private:
+    void runFake();
+    bool runIio(const QString &deviceDir);
+    void runSysfs(const QString &deviceDir);
+
+    void append(const Sensor6AxisData &sample);
+    void flush(bool force);
+    void filterBatch();
+    bool waitStopOr(int fd, short events, int timeoutMs, bool &ready);
+    int openTimer() const;
+    static qint64 monotonicUs();
+
+    QString m_iioName = "icm20608";
+    QString m_iioDevicesDir = "/sys/bus/iio/devices";
+    QString m_iioDevDir = "/dev";
+    QString m_fakePath;
+    int m_rateHz = 200;
+    int m_batchIntervalMs = 20;
+    bool m_filterEnabled = true;
+    ImuFilter::Config m_filterConfig;
+
+    int m_stopFd = -1;                   ///< eventfd，写入后唤醒 poll()
+    std::atomic<Backend> m_backend;
+
+    // 以下只在采集线程中使用
+    Sensor6AxisBatch m_batch;
+    ImuFilter m_filter;
+    ImuSoaBatch m_soa;
+    qint64 m_lastFlushUs = 0;
+};
+
+#endif // IMUACQUISITION_H
@@ -0,0 +1,303 @@
+#include "imufilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define IMUFILTER_HAVE_NEON
+#endif
+
+namespace {
+
+const float kPi = 3.14159265358979f;
+const float kRadToDeg = 180.0f / kPi;
+
+// atan(z), z ∈ [0, 1] 的最小最大多项式系数（奇次项，最大误差约 1e-5 rad）
+const float kAtanCoeffs[6] = {
+    0.99997726f, -0.33262347f, 0.19354346f, -0.11643287f, 0.05265332f, -0.01172120f
+};
+
+#ifdef IMUFILTER_HAVE_NEON
+
+inline float32x4_t neonReciprocal(float32x4_t x)
+{
+    float32x4_t r = vrecpeq_f32(x);
+    r = vmulq_f32(r, vrecpsq_f32(x, r));
+    r = vmulq_f32(r, vrecpsq_f32(x, r));
+    return r;
+}
+
+inline float32x4_t neonSqrt(float32x4_t x)
+{
+    // sqrt(x) = x * rsqrt(x)；x = 0 时估计值用一个极小正数代替，结果仍为 0
+    const float32x4_t safe = vmaxq_f32(x, vdupq_n_f32(1e-30f));
+    float32x4_t r = vrsqrteq_f32(safe);
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(safe, r), r));
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(safe, r), r));
+    return vmulq_f32(x, r);
+}
+
+/**
+ * @brief atan2(y, x)，弧度：先在 [0, 1] 上求 atan(min/max)，再按象限折回
+ */
+inline float32x4_t neonAtan2(float32x4_t y, float32x4_t x)
+{
+    const float32x4_t absY = vabsq_f32(y);
+    const float32x4_t absX = vabsq_f32(x);
+    const float32x4_t mx = vmaxq_f32(absX, absY);
+    const float32x4_t mn = vminq_f32(absX, absY);
+
+    // mx = 0（y = x = 0）时 z 取 0，结果为 0
+    const float32x4_t z = vmulq_f32(mn, neonReciprocal(vmaxq_f32(mx, vdupq_n_f32(1e-30f))));
+    const float32x4_t z2 = vmulq_f32(z, z);
+
+    float32x4_t p = vdupq_n_f32(kAtanCoeffs[5]);
+    for (int i = 4; i >= 0; i--)
+        p = vmlaq_f32(vdupq_n_f32(kAtanCoeffs[i]), p, z2);
+    float32x4_t r = vmulq_f32(p, z);
+
+    r = vbslq_f32(vcgtq_f32(absY, absX), vsubq_f32(vdupq_n_f32(kPi / 2), r), r);
+    r = vbslq_f32(vcltq_f32(x, vdupq_n_f32(0.0f)), vsubq_f32(vdupq_n_f32(kPi), r), r);
+    r = vbslq_f32(vcltq_f32(y, vdupq_n_f32(0.0f)), vnegq_f32(r), r);
+    return r;
+}
+
+#endif
+
+} // namespace
+
+/* ================= 一阶递推 ================= */
+
+void imu_iir_scalar(const float *u, float *y, size_t n, float a, float b, float *state)
+{
+    float prev = *state;
+    for (size_t i = 0; i < n; i++) {
+        prev = a * prev + b * u[i];
+        y[i] = prev;
+    }
+    *state = prev;
+}
+
+/**
+ * @brief 4 个样本一组：
+ *        y[k] = a^(k+1)*y[-1] + Σ(j<=k) b*a^(k-j)*u[j]，k = 0..3
+ *        与 u 相关的 4 项彼此独立，只有最后一次乘加依赖上一组的输出
+ */
+void imu_iir(const float *u, float *y, size_t n, float a, float b, float *state)
+{
+#ifdef IMUFILTER_HAVE_NEON
+    const float a2 = a * a, a3 = a2 * a, a4 = a3 * a;
+    const float powers[4] = { a, a2, a3, a4 };
+    const float col0[4] = { b, b * a, b * a2, b * a3 };
+    const float col1[4] = { 0, b, b * a, b * a2 };
+    const float col2[4] = { 0, 0, b, b * a };
+    const float col3[4] = { 0, 0, 0, b };
+
+    const float32x4_t p = vld1q_f32(powers);
+    const float32x4_t c0 = vld1q_f32(col0);
+    const float32x4_t c1 = vld1q_f32(col1);
+    const float32x4_t c2 = vld1q_f32(col2);
+    const float32x4_t c3 = vld1q_f32(col3);
+
+    float32x4_t prev = vdupq_n_f32(*state);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t x = vld1q_f32(u + i);
+        const float32x2_t lo = vget_low_f32(x);
+        const float32x2_t hi = vget_high_f32(x);
+
+        float32x4_t acc = vmulq_lane_f32(c0, lo, 0);
+        acc = vmlaq_lane_f32(acc, c1, lo, 1);
+        acc = vmlaq_lane_f32(acc, c2, hi, 0);
+        acc = vmlaq_lane_f32(acc, c3, hi, 1);
+        acc = vmlaq_f32(acc, p, prev);
+        vst1q_f32(y + i, acc);
+
+        prev = vdupq_lane_f32(vget_high_f32(acc), 1);
+    }
+
+    *state = vgetq_lane_f32(prev, 0);
+    imu_iir_scalar(u + i, y + i, n - i, a, b, state);
+#else
+    imu_iir_scalar(u, y, n, a, b, state);
+#endif
+}
+
+/* ================= 倾角 ================= */
+
+void imu_tilt_scalar(const float *ax, const float *ay, const float *az,
+                     float *roll, float *pitch, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        const float x = ax[i], y = ay[i], z = az[i];
+        roll[i] = std::atan2(y, z) * kRadToDeg;
+        pitch[i] = std::atan2(-x, std::sqrt(y * y + z * z)) * kRadToDeg;
+    }
+}
+
+void imu_tilt(const float *ax, const float *ay, const float *az,
+              float *roll, float *pitch, size_t n)
+{
+#ifdef IMUFILTER_HAVE_NEON
+    const float32x4_t toDeg = vdupq_n_f32(kRadToDeg);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t x = vld1q_f32(ax + i);
+        const float32x4_t y = vld1q_f32(ay + i);
+        const float32x4_t z = vld1q_f32(az + i);
+
+        const float32x4_t yz = neonSqrt(vmlaq_f32(vmulq_f32(y, y), z, z));
+        vst1q_f32(roll + i, vmulq_f32(neonAtan2(y, z), toDeg));
+        vst1q_f32(pitch + i, vmulq_f32(neonAtan2(vnegq_f32(x), yz), toDeg));
+    }
+    imu_tilt_scalar(ax + i, ay + i, az + i, roll + i, pitch + i, n - i);
+#else
+    imu_tilt_scalar(ax, ay, az, roll, pitch, n);
+#endif
+}
+
+/* ================= 滤波级 ================= */
+
+void ImuSoaBatch::resize(size_t n)
+{
+    for (std::vector<float> &v : axis) {
+        if (v.size() < n)
+            v.resize(n);
+    }
+    if (roll.size() < n)
+        roll.resize(n);
+    if (pitch.size() < n)
+        pitch.resize(n);
+    size = n;
+}
+
+ImuFilter::ImuFilter()
+    : m_useNeon(neonAvailable()), m_primed(false)
+{
+    configure(Config());
+}
+
+bool ImuFilter::neonAvailable()
+{
+#ifdef IMUFILTER_HAVE_NEON
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ImuFilter::configure(const Config &config)
+{
+    m_config = config;
+
+    const float dt = 1.0f / std::max(1.0f, config.sampleRateHz);
+
+    // 低通：y = y + α(x - y)，α = dt / (RC + dt)
+    if (config.lowPassHz > 0) {
+        const float rc = 1.0f / (2.0f * kPi * config.lowPassHz);
+        const float alpha = dt / (rc + dt);
+        m_lpA = 1.0f - alpha;
+        m_lpB = alpha;
+    } else {
+        m_lpA = 0.0f;   // 直通
+        m_lpB = 1.0f;
+    }
+
+    // 高通：y = β(y + x - x_prev)，β = RC / (RC + dt)
+    if (config.highPassHz > 0) {
+        const float rc = 1.0f / (2.0f * kPi * config.highPassHz);
+        m_hpA = rc / (rc + dt);
+    } else {
+        m_hpA = 0.0f;
+    }
+
+    // 互补滤波：k = τ / (τ + dt)
+    const float tau = std::max(0.0f, config.fusionTimeConstant);
+    m_fuseK = tau / (tau + dt);
+    m_fuseDt = dt;
+
+    reset();
+}
+
+void ImuFilter::reset()
+{
+    m_primed = false;
+}
+
+/**
+ * @brief 用第一个样本初始化状态
+ */
+void ImuFilter::prime(const ImuSoaBatch &batch)
+{
+    for (int c = 0; c < IMU_AXES; c++)
+        m_lowPass[c] = batch.axis[c][0];
+    for (int c = 0; c < 2; c++) {
+        m_hpInput[c] = batch.axis[IMU_GX + c][0];
+        m_hpOutput[c] = 0.0f;
+    }
+    imu_tilt_scalar(&batch.axis[IMU_AX][0], &batch.axis[IMU_AY][0], &batch.axis[IMU_AZ][0],
+                    &m_roll, &m_pitch, 1);
+    m_primed = true;
+}
+
+void ImuFilter::process(ImuSoaBatch &batch)
+{
+    const size_t n = batch.size;
+    if (n == 0)
+        return;
+
+    if (!m_primed)
+        prime(batch);
+
+    auto iir = m_useNeon ? imu_iir : imu_iir_scalar;
+    auto tilt = m_useNeon ? imu_tilt : imu_tilt_scalar;
+
+    // 1. 低通
+    for (int c = 0; c < IMU_AXES; c++) {
+        float *data = batch.axis[c].data();
+        iir(data, data, n, m_lpA, m_lpB, &m_lowPass[c]);
+    }
+
+    if (m_scratch.size() < n)
+        m_scratch.resize(n);
+    float *scratch = m_scratch.data();
+
+    // 2. 陀螺仪高通：u[i] = x[i] - x[i-1]，y = β*y + β*u
+    //    输出单独存放，batch.axis 保留低通后的测量值
+    const float *gyro[2] = { batch.axis[IMU_GX].data(), batch.axis[IMU_GY].data() };
+    if (m_hpA > 0) {
+        for (int c = 0; c < 2; c++) {
+            if (m_gyroHp[c].size() < n)
+                m_gyroHp[c].resize(n);
+            const float *data = gyro[c];
+            float prev = m_hpInput[c];
+            for (size_t i = 0; i < n; i++) {
+                scratch[i] = data[i] - prev;
+                prev = data[i];
+            }
+            m_hpInput[c] = prev;
+            iir(scratch, m_gyroHp[c].data(), n, m_hpA, m_hpA, &m_hpOutput[c]);
+            gyro[c] = m_gyroHp[c].data();
+        }
+    }
+
+    // 3. 互补滤波：u = (1-k)*accAngle + k*dt*gyro，angle = k*angle + u
+    float *roll = batch.roll.data();
+    float *pitch = batch.pitch.data();
+    tilt(batch.axis[IMU_AX].data(), batch.axis[IMU_AY].data(), batch.axis[IMU_AZ].data(),
+         roll, pitch, n);
+
+    const float accGain = 1.0f - m_fuseK;
+    const float gyroGain = m_fuseK * m_fuseDt;
+
+    const float *gx = gyro[0];
+    for (size_t i = 0; i < n; i++)
+        scratch[i] = accGain * roll[i] + gyroGain * gx[i];
+    iir(scratch, roll, n, m_fuseK, 1.0f, &m_roll);
+
+    const float *gy = gyro[1];
+    for (size_t i = 0; i < n; i++)
+        scratch[i] = accGain * pitch[i] + gyroGain * gy[i];
+    iir(scratch, pitch, n, m_fuseK, 1.0f, &m_pitch);
+}
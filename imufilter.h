@@ -0,0 +1,116 @@
+#ifndef IMUFILTER_H
+#define IMUFILTER_H
+
+#include <cstddef>
+#include <vector>
+
+/*
+ * 六轴数据滤波与姿态融合（按批处理，结构体数组转为数组结构体 SoA）
+ *
+ *  - imu_iir        : 一阶递推 y[n] = a*y[n-1] + b*u[n]，低通、高通、互补滤波都归结为这一形式；
+ *                     编译目标支持 NEON 时每次处理 4 个样本：把 4 步递推展开为
+ *                     下三角矩阵乘法，只有“上一块最后一个输出”这一项跨块依赖
+ *  - imu_tilt       : 由加速度计算横滚角/俯仰角（度）；NEON 实现使用多项式 atan2
+ *                     与倒数/平方根迭代，最大误差约 0.001°
+ *  - *_scalar       : 逐样本参考实现，也是非 NEON 平台的实现
+ *
+ * 所有函数只写入调用者提供的缓冲区，不做内存分配；输入输出可以是同一数组。
+ */
+
+enum ImuAxis {
+    IMU_AX, IMU_AY, IMU_AZ,   ///< 加速度 (g)
+    IMU_GX, IMU_GY, IMU_GZ,   ///< 角速度 (°/s)
+    IMU_AXES
+};
+
+/**
+ * @param state 输入为 y[-1]，返回时为最后一个输出
+ */
+void imu_iir_scalar(const float *u, float *y, size_t n, float a, float b, float *state);
+void imu_iir(const float *u, float *y, size_t n, float a, float b, float *state);
+
+/**
+ * @brief 横滚角 = atan2(ay, az)，俯仰角 = atan2(-ax, sqrt(ay² + az²))，单位度
+ */
+void imu_tilt_scalar(const float *ax, const float *ay, const float *az,
+                     float *roll, float *pitch, size_t n);
+void imu_tilt(const float *ax, const float *ay, const float *az,
+              float *roll, float *pitch, size_t n);
+
+/**
+ * @brief 一批样本（数组结构体），各数组长度均为 size
+ */
+struct ImuSoaBatch {
+    std::vector<float> axis[IMU_AXES];
+    std::vector<float> roll;    ///< 输出：横滚角 (°)
+    std::vector<float> pitch;   ///< 输出：俯仰角 (°)
+    size_t size = 0;
+
+    void resize(size_t n);      ///< 只增长容量，不释放
+};
+
+/**
+ * @brief 六轴滤波级（有状态，跨批次连续）
+ *
+ * 每批依次执行：
+ * 1. 6 个通道一阶低通（去除高频噪声），结果写回 batch.axis
+ * 2. 横滚/俯仰轴陀螺仪一阶高通（去除零偏漂移，截止频率为 0 时跳过），
+ *    结果只写入内部缓冲区作为互补滤波的输入，batch.axis 中的角速度不去除直流分量
+ * 3. 互补滤波：angle = k*(angle + gyro*dt) + (1-k)*accAngle，
+ *    短期信任陀螺仪积分，长期信任加速度计倾角
+ *
+ * 第一批的第一个样本用于初始化状态，避免滤波输出从 0 爬升。
+ * 非线程安全，应在产生样本的线程中使用。
+ */
+class ImuFilter
+{
+public:
+    struct Config {
+        float sampleRateHz = 200.0f;
+        float lowPassHz = 20.0f;       ///< 低通截止频率
+        float highPassHz = 0.05f;      ///< 陀螺仪高通截止频率，0 = 不做高通
+        float fusionTimeConstant = 0.5f; ///< 互补滤波时间常数 (s)
+    };
+
+    ImuFilter();
+
+    void configure(const Config &config);
+    const Config &config() const { return m_config; }
+
+    /**
+     * @brief 选择实现（用于对比测试），默认在支持 NEON 时使用 NEON
+     */
+    void setUseNeon(bool useNeon) { m_useNeon = useNeon && neonAvailable(); }
+    static bool neonAvailable();
+
+    /**
+     * @brief batch.axis 原地低通，并填充 roll/pitch
+     */
+    void process(ImuSoaBatch &batch);
+
+    /**
+     * @brief 清除状态，下一个样本重新初始化
+     */
+    void reset();
+
+private:
+    void prime(const ImuSoaBatch &batch);
+
+    Config m_config;
+    bool m_useNeon;
+    bool m_primed;
+
+    float m_lpA, m_lpB;        ///< 低通系数
+    float m_hpA;               ///< 高通系数
+    float m_fuseK, m_fuseDt;   ///< 互补滤波系数
+
+    float m_lowPass[IMU_AXES];   ///< 低通输出 y[n-1]
+    float m_hpInput[2];          ///< 高通输入 x[n-1]（gx、gy）
+    float m_hpOutput[2];         ///< 高通输出 y[n-1]
+    float m_roll, m_pitch;       ///< 互补滤波输出 y[n-1]
+
+    std::vector<float> m_scratch; ///< 差分/融合输入
+    std::vector<float> m_gyroHp[2]; ///< 高通后的 gx、gy，只供互补滤波读取
+};
+
+#endif // IMUFILTER_H
@@ -10,13 +10,14 @@
 #include <QDateTime>
 #include <QTextCursor>
 #include <QTextDocument>
-#include <QRandomGenerator>
 #include <QMenu>
 #include <QDir>
 #include <QFileInfoList>
 #include <QFileDialog>
 #include <QBuffer>
 
+#include "hexcodec.h"
+
 #include <QSslSocket>
 
 
@@ -43,9 +44,8 @@ MainWindow::MainWindow(QWidget *parent)
     /* 重设大小 */
     this->resize(list_screen.at(0)->geometry().width(),
                  list_screen.at(0)->geometry().height());
-    /* 默认是出厂系统的LED心跳的触发方式,想要控制LED，
-     * 需要改变LED的触发方式，改为none，即无 */
-    system("echo none > /sys/class/leds/sys-led/trigger");
+    /* 出厂系统的LED默认是心跳触发方式，想要控制LED需要改为none，
+     * 由 smartDeviceModule 构造时通过常驻的 sysfs 句柄写入，不再启动 shell */
 #else
     /* 否则则设置主窗体大小为1024*600 */
     this->resize(1024, 600);
@@ -58,6 +58,8 @@ MainWindow::MainWindow(QWidget *parent)
 
     deviceModule = new smartDeviceModule();
     g_serialModule = new serialModule(this);
+    // 串口读取放到独立线程，界面绘制不再延迟接收
+    g_serialModule->setIoThreadEnabled(true);
 
     initSerial();
     // 连接串口信号
@@ -67,47 +69,61 @@ MainWindow::MainWindow(QWidget *parent)
     connect(g_serialModule, &serialModule::errorOccurred,
             this, &MainWindow::onSerialError);
 
+    // 控制指令：流水线发送，按指令码匹配应答帧并统计延时。
+    // LED/继电器指令不一定幂等，也不保证有应答，因此不重发，超时只记录一次未应答
+    m_commandEngine = new CommandEngine(g_serialModule, this);
+    m_commandEngine->setWindowSize(4);
+    m_commandEngine->setTimeout(200);
+    m_commandEngine->setMaxRetries(0);
+    connect(m_commandEngine, &CommandEngine::commandSent, this,
+            [=](quint32, quint16, const QByteArray &frame, int) {
+        ui->textBrowser_send->append(QString("[%1] %2")
+                                     .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"))
+                                     .arg(byteArrayToHexString(frame)));
+    });
+    connect(m_commandEngine, &CommandEngine::commandCompleted, this,
+            [=](quint32, quint16 cmd, const QByteArray &, qint64 latencyUs) {
+        ui->textBrowser_send->append(QString("[%1] 指令 0x%2 应答, 耗时 %3 ms")
+                                     .arg(QTime::currentTime().toString("HH:mm:ss"))
+                                     .arg(cmd, 4, 16, QChar('0'))
+                                     .arg(latencyUs / 1000.0, 0, 'f', 1));
+    });
+    connect(m_commandEngine, &CommandEngine::commandFailed, this,
+            [=](quint32, quint16 cmd, const QString &reason) {
+        ui->textBrowser_send->append(QString("[%1] 指令 0x%2 未应答: %3")
+                                     .arg(QTime::currentTime().toString("HH:mm:ss"))
+                                     .arg(cmd, 4, 16, QChar('0'))
+                                     .arg(reason));
+    });
+
     // 初始化串口列表
     initPortList();
 
-    //start ap3216c
-    deviceModule->setCapture(false);
-
     // // 闹钟停止后的处理
     connect(deviceModule, &smartDeviceModule::alarmStopped,
             this, &MainWindow::onAlarmStopped);
     // 连接信号槽：当传感器数据更新时触发
-    connect(deviceModule, &smartDeviceModule::ap3216cDataUpdated,
+    connect(deviceModule, &smartDeviceModule::ap3216cSampleReady,
             this, &MainWindow::onAp3216cDataChanged);
+    connect(deviceModule, &smartDeviceModule::imuSamplesReady,
+            this, &MainWindow::onImuSamplesReady);
+
+    // ================== 传感器采集 ==================
+    // 六轴可通过 [imu] fake_source / SMARTDEVICE_FAKE_IMU 改用文件或 pty 回放，
+    // AP3216C 可通过 SMARTDEVICE_SYSFS_ROOT 指向模拟目录树（见 smartdevice_bench --create-only）
+    const PeripheralRegistry &peripherals = deviceModule->peripherals();
+    if (peripherals.isPresent(PeripheralRegistry::Ap3216c) ||
+        peripherals.hasIioDevice(PeripheralRegistry::Ap3216c))
+        deviceModule->setCapture(true);
+    else
+        qDebug() << "AP3216C not present, capture not started";
+
+    if (!peripherals.fakeSource(PeripheralRegistry::Imu).isEmpty() ||
+        peripherals.hasIioDevice(PeripheralRegistry::Imu))
+        deviceModule->setImuCapture(true);
+    else
+        qDebug() << "IMU not present, capture not started";
 
-    // ================== 模拟数据定时器 ==================
-    QTimer *testTimer = new QTimer(this);
-
-    connect(testTimer, &QTimer::timeout, this, [=]() {
-        Ap3216cData fakeData;
-        // 生成 0~65535 的 ALS 随机值
-        fakeData.als = QString::number(QRandomGenerator::global()->bounded(65536));
-        // 生成 0~1023 的 PS 随机值
-        fakeData.ps = QString::number(QRandomGenerator::global()->bounded(1024));
-        // 生成 0~1023 的 IR 随机值
-        fakeData.ir = QString::number(QRandomGenerator::global()->bounded(1024));
-        // 调用你原本的槽函数，模拟设备信号
-        onAp3216cDataChanged(fakeData);
-
-        // ===== 6轴传感器虚拟数据 =====
-        Sensor6AxisData sensor6;
-        sensor6.ax = QString::number(QRandomGenerator::global()->bounded(-2000, 2000) / 1000.0, 'f', 2); // -2~2 g
-        sensor6.ay = QString::number(QRandomGenerator::global()->bounded(-2000, 2000) / 1000.0, 'f', 2);
-        sensor6.az = QString::number(QRandomGenerator::global()->bounded(-2000, 2000) / 1000.0, 'f', 2);
-
-        sensor6.gx = QString::number(QRandomGenerator::global()->bounded(-250, 250), 'f', 1); // -250~250 °/s
-        sensor6.gy = QString::number(QRandomGenerator::global()->bounded(-250, 250), 'f', 1);
-        sensor6.gz = QString::number(QRandomGenerator::global()->bounded(-250, 250), 'f', 1);
-
-        on6AxisDataChanged(sensor6); // 更新 6 轴 UI
-    });
-
-    testTimer->start(1000); // 每 1 秒生成一次虚拟数据
     /*btn init*/
     initButtons();
     ap3216c_style_init();
@@ -129,80 +145,72 @@ MainWindow::MainWindow(QWidget *parent)
 
 MainWindow::~MainWindow()
 {
+    // m_photoProvider 是成员，在子控件 SlidePage 之前销毁，先解除绑定
+    if (m_slidePage)
+        m_slidePage->setProvider(nullptr);
     delete ui;
 }
 
 void MainWindow::loadPhotosToSlidePage()
 {
-    // 2️⃣ 手动生成资源文件列表（支持 1.png, 2.png ...）
-    QStringList fileList = {
-        ":/src/picture/1.png",
-        ":/src/picture/2.png",
-        ":/src/picture/3.png",
-        ":/src/picture/4.png",
-        ":/src/picture/5.png",
-        ":/src/picture/6.png",
-        ":/src/picture/7.png",
-        ":/src/picture/8.png",
-        ":/src/picture/exit.png",
-        ":/src/picture/last.png",
-        ":/src/picture/next.png"
-    };
-
-    if (fileList.isEmpty()) {
-        qDebug() << "未找到任何照片";
-        return;
-    }
-
-    qDebug() << "检测到照片数量:" << fileList.count();
-
-    ui->label_photo->setText(
-        QString("这是一个相册,检测到照片数量: %1 张, 滑动切换照片!").arg(fileList.count())
-    );
-
-    // 3️⃣ 创建 SlidePage
+    // 1️⃣ 创建 SlidePage
     SlidePage *slidePage = new SlidePage(ui->widget_photo);
+    m_slidePage = slidePage;
     slidePage->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
-    // 4️⃣ 遍历资源，每页显示 1 张
-    for (const QString &path : fileList) {
-        QWidget *page = new QWidget();
-        QVBoxLayout *vLayout = new QVBoxLayout(page);
-        vLayout->setContentsMargins(0, 0, 0, 0);
-        vLayout->setSpacing(0);
-        vLayout->setAlignment(Qt::AlignCenter);
-
-        QLabel *photoLabel = new QLabel();
-        photoLabel->setAlignment(Qt::AlignCenter);
-        photoLabel->setStyleSheet("background-color: lightgray; border-radius: 0px;");
-        photoLabel->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-
-        // 加载图片并自适应 slidePage 的大小
-        QPixmap pix(path);
-        if (!pix.isNull()) {
-            photoLabel->setPixmap(pix.scaled(ui->widget_photo->size(),
-                                             Qt::KeepAspectRatio,
-                                             Qt::SmoothTransformation));
-        } else {
-            photoLabel->setText("加载失败");
-        }
+    // 2️⃣ 按需加载：只解码当前页及相邻页；缓存图片模式下滑动时只贴两张预缩放的图片
+    slidePage->setProvider(&m_photoProvider);
+    slidePage->setRenderMode(SlidePage::PixmapMode);
+    connect(&m_photoProvider, &PhotoPageProvider::pixmapReady, slidePage, &SlidePage::updatePage);
+
+    // 3️⃣ 相册目录：扫描到或新增/删除的照片逐张同步到 SlidePage，不重新加载全部页面
+    m_album = new AlbumSource(this);
+    connect(m_album, &AlbumSource::fileInserted, this, [=](int index, const QString &path){
+        m_photoProvider.insertFile(index, path);
+        slidePage->insertPages(index);
+        updatePhotoCount();
+    });
+    connect(m_album, &AlbumSource::fileRemoved, this, [=](int index, const QString &){
+        m_photoProvider.removeFile(index);
+        slidePage->removePages(index);
+        updatePhotoCount();
+    });
+    connect(m_album, &AlbumSource::fileChanged, this, [=](int, const QString &path){
+        m_photoProvider.invalidateFile(path);
+        slidePage->reloadPages();
+    });
 
-        vLayout->addWidget(photoLabel);
-        slidePage->addPage(page);
-    }
+    const QString albumDir = AlbumSource::defaultDirectory();
+    if (!m_album->open(albumDir))
+        qDebug() << "相册目录不存在:" << albumDir;
+    updatePhotoCount();
 
-    // 5️⃣ 监听当前页变化
+    // 4️⃣ 监听当前页变化
     connect(slidePage, &SlidePage::currentPageIndexChanged, this, [=](int index){
         qDebug() << "当前滑动到第" << index + 1 << "页";
     });
 
-    // 6️⃣ 添加到 widget_photo 布局
+    // 5️⃣ 添加到 widget_photo 布局
     if (!ui->widget_photo->layout())
         ui->widget_photo->setLayout(new QVBoxLayout());
     ui->widget_photo->layout()->setContentsMargins(0, 0, 0, 0);
     ui->widget_photo->layout()->addWidget(slidePage);
 }
 
+void MainWindow::updatePhotoCount()
+{
+    if (m_photoProvider.pageCount() == 0) {
+        const QString dir = m_album->directory().isEmpty() ? AlbumSource::defaultDirectory()
+                                                           : m_album->directory();
+        ui->label_photo->setText(QString("这是一个相册,未找到任何照片 (%1)").arg(dir));
+        return;
+    }
+
+    ui->label_photo->setText(
+        QString("这是一个相册,检测到照片数量: %1 张, 滑动切换照片!").arg(m_photoProvider.pageCount())
+    );
+}
+
 
 
 void MainWindow::mainwindow_init()
@@ -384,6 +392,10 @@ void MainWindow::initSerial() ///< 初始化串口界面
     ui->comboBox_baund->setCurrentIndex(3);
     ui->comboBox_stop->setCurrentIndex(0);
 
+    // 接收日志：最多保留 2000 行，最多 30 Hz 刷新
+    ui->logView_uart_rev->setMaximumLines(2000);
+    ui->logView_uart_rev->setMaximumRefreshRate(30);
+
     connect(ui->lineEdit_uart_send, &QLineEdit::selectionChanged, this, [=]() {
         qDebug() << "lineEdit clicked!";
         QGuiApplication::inputMethod()->show();  // 手动显示键盘
@@ -514,102 +526,65 @@ void MainWindow::setButtonIcon(QToolButton *btn, const QString &iconPath)
     btn->setIconSize(QSize(200, 160));  // 保持和 QSS 一致的大小
 }
 
-void MainWindow::onAp3216cDataChanged(const Ap3216cData &data)
+void MainWindow::onAp3216cDataChanged(const Ap3216cSample &sample)
 {
-    bool ok;
-
-    // ================== ALS (环境光传感器) ==================
-    uint alsValue = data.als.toUInt(&ok);
-    if(!ok) alsValue = 0;
-    double alsPercent = static_cast<double>(alsValue) * 100.0 / 65535.0;
-
-    ui->lcdNumber_als->display(data.als);
-    ui->label_als->setText(QString("环境光强度: %1 lux\n百分比: %2%")
-                           .arg(alsValue)
-                           .arg(QString::number(alsPercent, 'f', 1)));
-
-    // ================== PS (接近传感器) ==================
-    uint psValue = data.ps.toUInt(&ok);
-    if(!ok) psValue = 0;
-    double psPercent = static_cast<double>(psValue) * 100.0 / 1023.0;
-
-    ui->lcdNumber_ps->display(data.ps);
-    ui->label_ps->setText(QString("接近传感器值: %1\n百分比: %2%")
-                          .arg(psValue)
-                          .arg(QString::number(psPercent, 'f', 1)));
-
-    // ================== IR (红外传感器) ==================
-    uint irValue = data.ir.toUInt(&ok);
-    if(!ok) irValue = 0;
-    double irPercent = static_cast<double>(irValue) * 100.0 / 1023.0;
-
-    ui->lcdNumber_ir->display(data.ir);
-    ui->label_ir->setText(QString("红外传感器值: %1\n百分比: %2%")
-                          .arg(irValue)
-                          .arg(QString::number(irPercent, 'f', 1)));
+    // 记录历史数据
+    m_sensorHistory.add(SensorHistory::Als, sample.timestampUs, sample.als);
+    m_sensorHistory.add(SensorHistory::Ps, sample.timestampUs, sample.ps);
+    m_sensorHistory.add(SensorHistory::Ir, sample.timestampUs, sample.ir);
+
+    // 只记录数值，由仪表盘按刷新率合并重绘
+    m_dashboard->setValue(SensorDashboard::Als, sample.als);
+    m_dashboard->setValue(SensorDashboard::Ps, sample.ps);
+    m_dashboard->setValue(SensorDashboard::Ir, sample.ir);
+}
+
+/**
+ * @brief 一批六轴样本：全部写入历史数据，界面只显示最新一个
+ */
+void MainWindow::onImuSamplesReady(const Sensor6AxisBatch &batch)
+{
+    if (batch.isEmpty())
+        return;
+
+    for (const Sensor6AxisData &sample : batch) {
+        m_sensorHistory.add(SensorHistory::Ax, sample.timestampUs, sample.ax);
+        m_sensorHistory.add(SensorHistory::Ay, sample.timestampUs, sample.ay);
+        m_sensorHistory.add(SensorHistory::Az, sample.timestampUs, sample.az);
+        m_sensorHistory.add(SensorHistory::Gx, sample.timestampUs, sample.gx);
+        m_sensorHistory.add(SensorHistory::Gy, sample.timestampUs, sample.gy);
+        m_sensorHistory.add(SensorHistory::Gz, sample.timestampUs, sample.gz);
+    }
+
+    on6AxisDataChanged(batch.last());
 }
 
 void MainWindow::on6AxisDataChanged(const Sensor6AxisData &data)
 {
-    bool ok;
-
-    // ================== 加速度 (a/g) ==================
-    double ax = data.ax.toDouble(&ok); if(!ok) ax = 0;
-    double ay = data.ay.toDouble(&ok); if(!ok) ay = 0;
-    double az = data.az.toDouble(&ok); if(!ok) az = 0;
-
-    // 百分比表示 (-2g~+2g -> 0~100%)
-    double axPercent = (ax + 2.0) * 100.0 / 4.0;
-    double ayPercent = (ay + 2.0) * 100.0 / 4.0;
-    double azPercent = (az + 2.0) * 100.0 / 4.0;
-
-    // 更新 LCD 显示
-    ui->lcdNumber_ax->display(ax);
-    ui->lcdNumber_ay->display(ay);
-    ui->lcdNumber_az->display(az);
-
-    // 更新 label 显示
-    ui->label_ax->setText(QString("AX: %1 g\n百分比: %2%")
-                          .arg(ax, 0, 'f', 2)
-                          .arg(QString::number(axPercent, 'f', 1)));
-    ui->label_ay->setText(QString("AY: %1 g\n百分比: %2%")
-                          .arg(ay, 0, 'f', 2)
-                          .arg(QString::number(ayPercent, 'f', 1)));
-    ui->label_az->setText(QString("AZ: %1 g\n百分比: %2%")
-                          .arg(az, 0, 'f', 2)
-                          .arg(QString::number(azPercent, 'f', 1)));
-
-    // ================== 陀螺仪 (°/s) ==================
-    double gx = data.gx.toDouble(&ok); if(!ok) gx = 0;
-    double gy = data.gy.toDouble(&ok); if(!ok) gy = 0;
-    double gz = data.gz.toDouble(&ok); if(!ok) gz = 0;
-
-    // 百分比表示 (-250~+250 °/s -> 0~100%)
-    double gxPercent = (gx + 250.0) * 100.0 / 500.0;
-    double gyPercent = (gy + 250.0) * 100.0 / 500.0;
-    double gzPercent = (gz + 250.0) * 100.0 / 500.0;
-
-    // 更新 LCD 显示
-    ui->lcdNumber_gx->display(gx);
-    ui->lcdNumber_gy->display(gy);
-    ui->lcdNumber_gz->display(gz);
-
-    // 更新 label 显示
-    ui->label_gx->setText(QString("GX: %1 °/s\n百分比: %2%")
-                          .arg(gx, 0, 'f', 1)
-                          .arg(QString::number(gxPercent, 'f', 1)));
-    ui->label_gy->setText(QString("GY: %1 °/s\n百分比: %2%")
-                          .arg(gy, 0, 'f', 1)
-                          .arg(QString::number(gyPercent, 'f', 1)));
-    ui->label_gz->setText(QString("GZ: %1 °/s\n百分比: %2%")
-                          .arg(gz, 0, 'f', 1)
-                          .arg(QString::number(gzPercent, 'f', 1)));
+    m_dashboard->setValue(SensorDashboard::Ax, data.ax);
+    m_dashboard->setValue(SensorDashboard::Ay, data.ay);
+    m_dashboard->setValue(SensorDashboard::Az, data.az);
+    m_dashboard->setValue(SensorDashboard::Gx, data.gx);
+    m_dashboard->setValue(SensorDashboard::Gy, data.gy);
+    m_dashboard->setValue(SensorDashboard::Gz, data.gz);
 }
 
 
 void MainWindow::ap3216c_style_init()
 {
-
+    // 传感器页面的 LCD 与说明文字交给仪表盘统一刷新
+    m_dashboard = new SensorDashboard(this);
+    m_dashboard->bind(SensorDashboard::Als, ui->lcdNumber_als, ui->label_als, "环境光强度: ", " lux", 0, 0, 65535);
+    m_dashboard->bind(SensorDashboard::Ps,  ui->lcdNumber_ps,  ui->label_ps,  "接近传感器值: ", "", 0, 0, 1023);
+    m_dashboard->bind(SensorDashboard::Ir,  ui->lcdNumber_ir,  ui->label_ir,  "红外传感器值: ", "", 0, 0, 1023);
+
+    // 加速度 -2g~+2g，陀螺仪 -250~+250 °/s
+    m_dashboard->bind(SensorDashboard::Ax, ui->lcdNumber_ax, ui->label_ax, "AX: ", " g", 2, -2, 2);
+    m_dashboard->bind(SensorDashboard::Ay, ui->lcdNumber_ay, ui->label_ay, "AY: ", " g", 2, -2, 2);
+    m_dashboard->bind(SensorDashboard::Az, ui->lcdNumber_az, ui->label_az, "AZ: ", " g", 2, -2, 2);
+    m_dashboard->bind(SensorDashboard::Gx, ui->lcdNumber_gx, ui->label_gx, "GX: ", " °/s", 1, -250, 250);
+    m_dashboard->bind(SensorDashboard::Gy, ui->lcdNumber_gy, ui->label_gy, "GY: ", " °/s", 1, -250, 250);
+    m_dashboard->bind(SensorDashboard::Gz, ui->lcdNumber_gz, ui->label_gz, "GZ: ", " °/s", 1, -250, 250);
 }
 
 
@@ -672,28 +647,14 @@ void MainWindow::onSerialDataReceived(const QByteArray &data)
 
     if (!ui->checkBox_rev->isChecked()) {
         // 复选框选中时，显示ASCII格式
-        QString asciiData;
-        for (char c : data) {
-            if (c >= 32 && c <= 126) { // 可打印ASCII字符
-                asciiData.append(c);
-            } else {
-                asciiData.append('.');
-            }
-        }
-        displayText = QString("[%1] ASCII: %2").arg(timestamp).arg(asciiData);
+        displayText = QString("[%1] ASCII: %2").arg(timestamp).arg(byteArrayToAsciiString(data));
     } else {
         // 复选框未选中时，显示十六进制格式
-        QString hexData = data.toHex(' ').toUpper();
-        displayText = QString("[%1] HEX: %2").arg(timestamp).arg(hexData);
+        displayText = QString("[%1] HEX: %2").arg(timestamp).arg(byteArrayToHexString(data));
     }
 
-    // 追加到文本浏览器
-    ui->textBrowser_uart_rev->append(displayText);
-
-    // 自动滚动到底部
-    QTextCursor cursor = ui->textBrowser_uart_rev->textCursor();
-    cursor.movePosition(QTextCursor::End);
-    ui->textBrowser_uart_rev->setTextCursor(cursor);
+    // 追加到日志控件（重绘由控件合并，自动跟随最新行）
+    ui->logView_uart_rev->appendLine(displayText);
 }
 
 /**
@@ -727,7 +688,7 @@ void MainWindow::on_openBtn_clicked(bool checked)
 
 void MainWindow::on_clear_rev_Btn_clicked()
 {
-    ui->textBrowser_uart_rev->clear();
+    ui->logView_uart_rev->clear();
 }
 
 void MainWindow::on_clear_send_Btn_clicked()
@@ -763,7 +724,7 @@ void MainWindow::on_sendBtn_clicked()
             g_serialModule->sendData(hexData);
 
             // 显示十六进制格式
-            displayText = hexData.toHex(' ').toUpper(); // 空格分隔，每个字节两位
+            displayText = byteArrayToHexString(hexData); // 空格分隔，每个字节两位
         } else {
             // ASCII模式发送
             g_serialModule->sendData(textToSend);
@@ -784,32 +745,53 @@ void MainWindow::on_sendBtn_clicked()
 
 /**
  * @brief 将十六进制字符串转换为字节数组
+ *
+ * 直接在 QString 的 UTF-16 数据上单遍查表解码，空白字符跳过，
+ * 非法字符或位数为奇数时返回空数组
  */
 QByteArray MainWindow::hexStringToByteArray(const QString &hexString)
 {
-    QByteArray byteArray;
-    QString cleanString = hexString.trimmed().remove(' ').remove('\n').remove('\r').remove('\t');
+    const size_t len = static_cast<size_t>(hexString.size());
+    QByteArray byteArray(static_cast<int>(hex_decoded_max_size(len)), Qt::Uninitialized);
 
-    // 检查长度是否为偶数
-    if (cleanString.length() % 2 != 0) {
+    size_t decoded = 0;
+    if (!hex_decode(reinterpret_cast<const uint16_t *>(hexString.utf16()), len,
+                    reinterpret_cast<uint8_t *>(byteArray.data()), &decoded)) {
         return QByteArray();
     }
 
-    bool ok;
-    for (int i = 0; i < cleanString.length(); i += 2) {
-        QString byteString = cleanString.mid(i, 2);
-        uchar byteValue = byteString.toUShort(&ok, 16);
-        if (!ok) {
-            return QByteArray();
-        }
-        byteArray.append(byteValue);
-    }
-
+    byteArray.resize(static_cast<int>(decoded));
     return byteArray;
 }
 
+/**
+ * @brief 字节数组转为大写十六进制显示文本，字节间以空格分隔
+ */
+QString MainWindow::byteArrayToHexString(const QByteArray &data)
+{
+    const size_t len = static_cast<size_t>(data.size());
+    QByteArray text(static_cast<int>(hex_encoded_size(len, ' ')), Qt::Uninitialized);
+    hex_encode(reinterpret_cast<const uint8_t *>(data.constData()), len, text.data(), ' ');
+    return QString::fromLatin1(text);
+}
 
-void MainWindow::on_Btn_1_clicked() {
+/**
+ * @brief 字节数组转为 ASCII 显示文本，不可打印字符显示为 '.'
+ */
+QString MainWindow::byteArrayToAsciiString(const QByteArray &data)
+{
+    QByteArray text(data.size(), Qt::Uninitialized);
+    ascii_printable(reinterpret_cast<const uint8_t *>(data.constData()),
+                    static_cast<size_t>(data.size()), text.data());
+    return QString::fromLatin1(text);
+}
+
+
+/**
+ * @brief 通过指令引擎发送一条控制指令（payload 固定为 01 00），发出的帧由 commandSent 记录
+ */
+void MainWindow::sendControlCommand(quint16 cmd)
+{
     // 判断串口是否打开
     if (!g_serialModule->isOpen()) {
         QMessageBox::warning(this, "错误", "串口未打开，无法发送数据！");
@@ -817,74 +799,23 @@ void MainWindow::on_Btn_1_clicked() {
     }
 
     QByteArray payload("\x01\x00", 2);           // payload 固定为 01 00
-    QByteArray data = g_serialModule->packCommand(0x0101, payload);
-    g_serialModule->sendData(data);
-
-    // 获取当前日期和时间
-    QString dateTimeStr = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss");
-
-    ui->textBrowser_send->append(QString("[%1] %2")
-                                 .arg(dateTimeStr)
-                                 .arg(QString(data.toHex(' ').toUpper())));
+    m_commandEngine->submit(cmd, payload);
+}
 
+void MainWindow::on_Btn_1_clicked() {
+    sendControlCommand(0x0101);
 }
 
 void MainWindow::on_Btn_2_clicked() {
-    // 判断串口是否打开
-    if (!g_serialModule->isOpen()) {
-        QMessageBox::warning(this, "错误", "串口未打开，无法发送数据！");
-        return;
-    }
-
-    QByteArray payload("\x01\x00", 2);
-    QByteArray data = g_serialModule->packCommand(0x0102, payload);
-    g_serialModule->sendData(data);
-    // 获取当前日期和时间
-    QString dateTimeStr = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss");
-
-    ui->textBrowser_send->append(QString("[%1] %2")
-                                 .arg(dateTimeStr)
-                                 .arg(QString(data.toHex(' ').toUpper())));
-
+    sendControlCommand(0x0102);
 }
 
 void MainWindow::on_Btn_6_clicked() {
-
-    // 判断串口是否打开
-    if (!g_serialModule->isOpen()) {
-        QMessageBox::warning(this, "错误", "串口未打开，无法发送数据！");
-        return;
-    }
-
-    QByteArray payload("\x01\x00", 2);
-    QByteArray data = g_serialModule->packCommand(0x0601, payload);
-    g_serialModule->sendData(data);
-    // 获取当前日期和时间
-    QString dateTimeStr = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss");
-
-    ui->textBrowser_send->append(QString("[%1] %2")
-                                 .arg(dateTimeStr)
-                                 .arg(QString(data.toHex(' ').toUpper())));
-
+    sendControlCommand(0x0601);
 }
 
 void MainWindow::on_Btn_7_clicked() {
-    // 判断串口是否打开
-    if (!g_serialModule->isOpen()) {
-        QMessageBox::warning(this, "错误", "串口未打开，无法发送数据！");
-        return;
-    }
-
-    QByteArray payload("\x01\x00", 2);
-    QByteArray data = g_serialModule->packCommand(0x0602, payload);
-    g_serialModule->sendData(data);
-    // 获取当前日期和时间
-    QString dateTimeStr = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss");
-
-    ui->textBrowser_send->append(QString("[%1] %2")
-                                 .arg(dateTimeStr)
-                                 .arg(QString(data.toHex(' ').toUpper())));
-
+    sendControlCommand(0x0602);
 }
 
 
@@ -10,7 +10,12 @@
 
 
 #include "serialmodule.h"
+#include "commandengine.h"
 #include "smartdevicemodule.h"
+#include "sensorhistory.h"
+#include "sensordashboard.h"
+#include "photopageprovider.h"
+#include "albumsource.h"
 #include "musicmodule.h"
 #include "baidu_ocr.h"    // 车牌识别类
 
@@ -48,7 +53,8 @@ private slots:
     void on_uartBtn_clicked(bool checked);
 
     void onAlarmStopped(); // 闹钟停止后的处理
-    void onAp3216cDataChanged(const Ap3216cData &data);
+    void onAp3216cDataChanged(const Ap3216cSample &sample);
+    void onImuSamplesReady(const Sensor6AxisBatch &batch);
     void on6AxisDataChanged(const Sensor6AxisData &data);
     void ap3216c_style_init();
 
@@ -115,6 +121,9 @@ private:
 	void initSerial();     ///< 初始化串口界面
     void initPortList();  // 初始化串口列表
     void initBaiduOcr();    //百度车牌识别初始化界面
+    void sendControlCommand(quint16 cmd);   // 通过指令引擎发送控制指令
+    static QString byteArrayToHexString(const QByteArray &data);   // 字节 -> "AA 0B ..." 显示文本
+    static QString byteArrayToAsciiString(const QByteArray &data); // 不可打印字符显示为 '.'
     QMovie *movie;          //gif效果
 
     // MainWindow 成员变量
@@ -122,6 +131,13 @@ private:
 
     smartDeviceModule *deviceModule;
     serialModule *g_serialModule;
+    CommandEngine *m_commandEngine;     // 串口控制指令引擎
+    SensorHistory m_sensorHistory;      // 传感器历史数据（趋势图/异常检测）
+    SensorDashboard *m_dashboard = nullptr; // 传感器页面 LCD/文字的合并刷新
+    PhotoPageProvider m_photoProvider;  // 相册页面按需加载（比 SlidePage 先销毁，析构时先解除绑定）
+    SlidePage *m_slidePage = nullptr;   // 相册页面，ui->widget_photo 的子控件
+    AlbumSource *m_album = nullptr;     // 相册目录（扫描 + inotify 监视）
+    void updatePhotoCount();
     /**
      * 车牌识别相关
      */
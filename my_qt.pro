@@ -2,7 +2,10 @@ QT       += core gui serialport virtualkeyboard multimedia multimediawidgets
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
-CONFIG += c++11
+CONFIG += c++14
+
+# CRC16 实现选择（见 crc16.h）：CRC16_IMPL_BITWISE / CRC16_IMPL_TABLE / CRC16_IMPL_SLICE8（默认）
+#DEFINES += CRC16_IMPL_TABLE
 
 # The following define makes your compiler emit warnings if you use
 # any Qt feature that has been marked deprecated (the exact warnings
@@ -16,24 +19,69 @@ DEFINES += QT_DEPRECATED_WARNINGS
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    albumsource.cpp \
+    ap3216cacquisition.cpp \
     baidu_ocr.cpp \
+    beeppatternplayer.cpp \
+    commandengine.cpp \
+    crc16.cpp \
+    hexcodec.cpp \
+    iiobufferreader.cpp \
+    imagecache.cpp \
+    imagedecodeservice.cpp \
+    imuacquisition.cpp \
+    imufilter.cpp \
     main.cpp \
     mainwindow.cpp \
     musicmodule.cpp \
+    peripheralregistry.cpp \
+    photopageprovider.cpp \
+    sensordashboard.cpp \
+    sensorhistory.cpp \
+    sensorlog.cpp \
+    serialcapture.cpp \
+    serialframeparser.cpp \
+    serialioworker.cpp \
     serialmodule.cpp \
+    serialstats.cpp \
     smartdevicemodule.cpp \
+    sysfsfilecache.cpp \
     widgets/arcgraph/arcgraph.cpp \
     widgets/glowtext/glowtext.cpp \
+    widgets/logview/logview.cpp \
     slidepage/slidepage.cpp
 
 HEADERS += \
+    albumsource.h \
+    ap3216cacquisition.h \
     baidu_ocr.h \
+    beeppatternplayer.h \
+    commandengine.h \
+    crc16.h \
+    hexcodec.h \
+    iiobufferreader.h \
+    imagecache.h \
+    imagedecodeservice.h \
+    imuacquisition.h \
+    imufilter.h \
     mainwindow.h \
     musicmodule.h \
+    peripheralregistry.h \
+    photopageprovider.h \
+    sensordashboard.h \
+    sensorhistory.h \
+    sensorlog.h \
+    serialcapture.h \
+    serialframeparser.h \
+    serialioworker.h \
     serialmodule.h \
+    serialstats.h \
     smartdevicemodule.h \
+    sysfsfilecache.h \
+    spscqueue.h \
     widgets/arcgraph/arcgraph.h \
     widgets/glowtext/glowtext.h \
+    widgets/logview/logview.h \
     slidepage/slidepage.h
 
 FORMS += \
@@ -44,5 +92,25 @@ qnx: target.path = /tmp/$${TARGET}/bin
 else: unix:!android: target.path = /opt/$${TARGET}/bin
 !isEmpty(target.path): INSTALLS += target
 
+# 相册照片不再编译进资源文件，安装到磁盘目录，运行时由 AlbumSource 扫描
+# （可用环境变量 SMARTDEVICE_ALBUM_DIR 指定其他目录）。
+# 未执行 make install 时安装目录不存在，回退到源码树中的 src/picture
+DEFINES += ALBUM_SOURCE_DIR=\\\"$$PWD/src/picture\\\"
+qnx: photos.path = /tmp/$${TARGET}/photos
+else: unix:!android: photos.path = /opt/$${TARGET}/photos
+photos.files = \
+    src/picture/1.png \
+    src/picture/2.png \
+    src/picture/3.png \
+    src/picture/4.png \
+    src/picture/5.png \
+    src/picture/6.png \
+    src/picture/7.png \
+    src/picture/8.png
+!isEmpty(photos.path) {
+    INSTALLS += photos
+    DEFINES += ALBUM_DEFAULT_DIR=\\\"$$photos.path\\\"
+}
+
 RESOURCES += \
     src.qrc
@@ -0,0 +1,93 @@
+#include "peripheralregistry.h"
+#include "iiobufferreader.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QSettings>
+
+const char *PeripheralRegistry::sectionName(Peripheral peripheral)
+{
+    static const char *const names[PeripheralCount] = {
+        "led", "beep", "alarm", "ap3216c", "imu"
+    };
+    return peripheral >= 0 && peripheral < PeripheralCount ? names[peripheral] : "";
+}
+
+bool PeripheralRegistry::load(const QString &configPath)
+{
+    QStringList candidates;
+    if (!configPath.isEmpty())
+        candidates << configPath;
+    const QString env = QString::fromLocal8Bit(qgetenv("SMARTDEVICE_CONFIG"));
+    if (!env.isEmpty())
+        candidates << env;
+    candidates << "/etc/smartdevice/peripherals.ini"
+               << ":/config/peripherals.ini";
+
+    m_source.clear();
+    for (const QString &candidate : candidates) {
+        if (QFileInfo::exists(candidate)) {
+            m_source = candidate;
+            break;
+        }
+    }
+
+    for (Entry &entry : m_entries)
+        entry = Entry();
+    m_root = QString::fromLocal8Bit(qgetenv("SMARTDEVICE_SYSFS_ROOT"));
+    m_logDir = QString::fromLocal8Bit(qgetenv("SMARTDEVICE_LOG_DIR"));
+    m_logMaxSegments = 64;
+    m_entries[Imu].fakeSource = QString::fromLocal8Bit(qgetenv("SMARTDEVICE_FAKE_IMU"));
+
+    if (m_source.isEmpty()) {
+        qDebug() << "PeripheralRegistry: no config file found";
+        return false;
+    }
+
+    QSettings settings(m_source, QSettings::IniFormat);
+    if (m_root.isEmpty())
+        m_root = settings.value("general/sysfs_root").toString().trimmed();
+    while (m_root.endsWith('/'))
+        m_root.chop(1);
+    if (m_logDir.isEmpty())
+        m_logDir = settings.value("log/dir").toString().trimmed();
+    m_logMaxSegments = qMax(1, settings.value("log/max_segments", 64).toInt());
+
+    for (int i = 0; i < PeripheralCount; ++i) {
+        const Peripheral peripheral = static_cast<Peripheral>(i);
+        Entry &entry = m_entries[i];
+
+        settings.beginGroup(sectionName(peripheral));
+        entry.path = settings.value("path").toString().trimmed();
+        entry.iioName = settings.value("iio_name").toString().trimmed();
+        if (entry.fakeSource.isEmpty())
+            entry.fakeSource = settings.value("fake_source").toString().trimmed();
+        settings.endGroup();
+
+        while (entry.path.size() > 1 && entry.path.endsWith('/'))
+            entry.path.chop(1);
+        if (!entry.path.isEmpty())
+            entry.path.prepend(m_root);
+
+        entry.present = !entry.path.isEmpty() && QFileInfo(entry.path).isDir();
+        if (!entry.path.isEmpty() && !entry.present)
+            qDebug() << "PeripheralRegistry:" << sectionName(peripheral) << entry.path << "not found";
+    }
+
+    qDebug() << "PeripheralRegistry: loaded" << m_source << (m_root.isEmpty() ? QString() : "root " + m_root);
+    return true;
+}
+
+QString PeripheralRegistry::attribute(Peripheral peripheral, const char *name) const
+{
+    const QString &dir = m_entries[peripheral].path;
+    if (dir.isEmpty())
+        return QString();
+    return dir + '/' + QLatin1String(name);
+}
+
+bool PeripheralRegistry::hasIioDevice(Peripheral peripheral) const
+{
+    const QString &name = m_entries[peripheral].iioName;
+    return !name.isEmpty() && !IioBufferReader::findDevice(name, iioDevicesDir()).isEmpty();
+}
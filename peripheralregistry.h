@@ -0,0 +1,81 @@
+#ifndef PERIPHERALREGISTRY_H
+#define PERIPHERALREGISTRY_H
+
+#include <QString>
+
+/**
+ * @brief 外设映射表
+ *
+ * 启动时从配置文件（INI，格式见 config/peripherals.ini）读取一次各外设的 sysfs 目录
+ * 与 IIO 设备名，并检查目录是否存在。之后各模块只按枚举取路径，
+ * 在初始化阶段一次性注册/打开属性文件，热路径上不再拼接路径。
+ *
+ * 配置文件查找顺序：
+ * 1. load() 参数指定的文件
+ * 2. 环境变量 SMARTDEVICE_CONFIG
+ * 3. /etc/smartdevice/peripherals.ini
+ * 4. 程序内置的 :/config/peripherals.ini
+ *
+ * 所有路径都加上 sysfs 根目录前缀（环境变量 SMARTDEVICE_SYSFS_ROOT，其次配置文件
+ * [general] sysfs_root，默认为空即真实的 /sys、/dev），
+ * 指向 tmpfs 中模拟的目录树即可在开发机上运行和测试外设 I/O。
+ */
+class PeripheralRegistry
+{
+public:
+    enum Peripheral {
+        Led,
+        Beep,
+        Alarm,
+        Ap3216c,
+        Imu,
+        PeripheralCount
+    };
+
+    struct Entry {
+        QString path;       ///< sysfs 设备目录（不含结尾的 '/'），未配置时为空
+        QString iioName;    ///< IIO 设备名，未配置时为空
+        QString fakeSource; ///< 模拟数据源（文件/pty，目前只有六轴支持），未配置时为空
+        bool present = false; ///< path 已配置且目录存在
+    };
+
+    PeripheralRegistry() = default;
+
+    /**
+     * @brief 读取配置文件
+     * @param configPath 为空时按查找顺序选择
+     * @return 找到并读取了配置文件返回true
+     */
+    bool load(const QString &configPath = QString());
+
+    const Entry &entry(Peripheral peripheral) const { return m_entries[peripheral]; }
+    bool isPresent(Peripheral peripheral) const { return m_entries[peripheral].present; }
+    bool hasIioDevice(Peripheral peripheral) const;   ///< iio_name 已配置且能找到对应 IIO 设备
+    QString path(Peripheral peripheral) const { return m_entries[peripheral].path; }
+    QString iioName(Peripheral peripheral) const { return m_entries[peripheral].iioName; }
+    QString fakeSource(Peripheral peripheral) const { return m_entries[peripheral].fakeSource; }
+
+    /**
+     * @brief 属性文件路径（设备目录 + "/" + 属性名），未配置时为空
+     */
+    QString attribute(Peripheral peripheral, const char *name) const;
+
+    QString source() const { return m_source; }   ///< 实际读取的配置文件
+    QString sysfsRoot() const { return m_root; }  ///< 根目录前缀，为空表示真实设备
+    QString logDir() const { return m_logDir; }   ///< 传感器日志目录，为空表示不记录
+    int logMaxSegments() const { return m_logMaxSegments; } ///< 日志保留的段文件数
+
+    QString iioDevicesDir() const { return m_root + "/sys/bus/iio/devices"; } ///< IIO 设备目录
+    QString devDir() const { return m_root + "/dev"; }                        ///< 字符设备目录
+
+    static const char *sectionName(Peripheral peripheral);
+
+private:
+    Entry m_entries[PeripheralCount];
+    QString m_source;
+    QString m_root;
+    QString m_logDir;
+    int m_logMaxSegments = 64;
+};
+
+#endif // PERIPHERALREGISTRY_H
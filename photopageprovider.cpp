@@ -0,0 +1,120 @@
+#include "photopageprovider.h"
+
+#include <QLabel>
+#include <QPixmap>
+#include <QSet>
+
+PhotoPageProvider::PhotoPageProvider(const QStringList &files, QObject *parent)
+    : QObject(parent),
+      m_files(files)
+{
+    m_cache.prune();
+    m_decoder.setCache(&m_cache);
+    connect(&m_decoder, &ImageDecodeService::decoded, this, &PhotoPageProvider::onDecoded);
+}
+
+QWidget *PhotoPageProvider::createPage()
+{
+    QLabel *photoLabel = new QLabel();
+    photoLabel->setAlignment(Qt::AlignCenter);
+    photoLabel->setStyleSheet("background-color: lightgray; border-radius: 0px;");
+    return photoLabel;
+}
+
+/**
+ * @brief 请求后台解码第 index 张照片，缩放到页面尺寸
+ *
+ * SlidePage 先绑定当前页再绑定两侧，按绑定顺序递减优先级，当前页最先解码。
+ */
+void PhotoPageProvider::bindPage(QWidget *page, int index)
+{
+    QLabel *photoLabel = static_cast<QLabel *>(page);
+    photoLabel->clear();
+
+    const quint64 id = m_decoder.request(m_files.value(index), page->size(), -(m_bindOrder++));
+    m_requests.insert(id, photoLabel);
+    m_pageRequest.insert(page, id);
+}
+
+/**
+ * @brief 离开显示窗口的页面取消未完成的解码并释放像素数据
+ */
+void PhotoPageProvider::unbindPage(QWidget *page, int index)
+{
+    Q_UNUSED(index);
+
+    const quint64 id = m_pageRequest.take(page);
+    if (id) {
+        m_decoder.cancel(id);
+        m_requests.remove(id);
+    }
+    static_cast<QLabel *>(page)->clear();
+}
+
+/**
+ * @brief 缓存图片模式：释放窗口外的图片、取消窗口外的请求，从当前页向两侧请求缺少的图片
+ */
+void PhotoPageProvider::preparePixmaps(int current, int first, int last, const QSize &size)
+{
+    // 尺寸变化后已有的图片和请求都作废
+    const bool resized = size != m_pixmapSize;
+    if (resized) {
+        m_pixmaps.clear();
+        m_pixmapSize = size;
+    }
+
+    QSet<QString> wanted;
+    for (int index = first; index <= last; ++index)
+        wanted.insert(m_files.value(index));
+
+    for (auto it = m_pixmaps.begin(); it != m_pixmaps.end(); ) {
+        if (wanted.contains(it.key()))
+            ++it;
+        else
+            it = m_pixmaps.erase(it);
+    }
+    for (auto it = m_pixmapRequests.begin(); it != m_pixmapRequests.end(); ) {
+        if (wanted.contains(it.key()) && !resized) {
+            ++it;
+        } else {
+            m_decoder.cancel(it.value());
+            it = m_pixmapRequests.erase(it);
+        }
+    }
+
+    for (int index = first; index <= last; ++index) {
+        const QString path = m_files.value(index);
+        if (m_pixmaps.contains(path) || m_pixmapRequests.contains(path))
+            continue;
+        m_pixmapRequests.insert(path, m_decoder.request(path, size, -qAbs(index - current)));
+    }
+}
+
+void PhotoPageProvider::invalidateFile(const QString &path)
+{
+    m_pixmaps.remove(path);
+    const quint64 id = m_pixmapRequests.take(path);
+    if (id)
+        m_decoder.cancel(id);
+}
+
+void PhotoPageProvider::onDecoded(quint64 id, const QString &path, const QImage &image)
+{
+    // 缓存图片模式的请求
+    if (m_pixmapRequests.value(path) == id) {
+        m_pixmapRequests.remove(path);
+        m_pixmaps.insert(path, QPixmap::fromImage(image));
+        emit pixmapReady(m_files.indexOf(path));
+        return;
+    }
+
+    QLabel *photoLabel = m_requests.take(id);
+    if (!photoLabel)
+        return;
+    m_pageRequest.remove(photoLabel);
+
+    if (image.isNull())
+        photoLabel->setText("加载失败");
+    else
+        photoLabel->setPixmap(QPixmap::fromImage(image));
+}
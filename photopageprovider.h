@@ -0,0 +1,72 @@
+#ifndef PHOTOPAGEPROVIDER_H
+#define PHOTOPAGEPROVIDER_H
+
+#include <QHash>
+#include <QObject>
+#include <QPixmap>
+#include <QStringList>
+
+#include "imagecache.h"
+#include "imagedecodeservice.h"
+#include "slidepage/slidepage.h"
+
+class QLabel;
+
+/**
+ * @brief 相册页面提供者
+ *
+ * 每页一个 QLabel 显示一张照片。只有绑定到页面时才请求解码，解码和缩放在
+ * ImageDecodeService 的线程池中完成，GUI线程只把结果转换为 QPixmap；
+ * 页面在结果返回前被划走时取消请求。按页面尺寸缩放后的图片保存在 ImageCache 中，
+ * 再次启动时直接映射缓存文件，不再解码 PNG。解绑时释放像素数据，
+ * 内存占用只与 SlidePage 保留的页面控件数量有关，与照片总数无关。
+ *
+ * SlidePage 的缓存图片模式下不使用页面控件：preparePixmaps() 请求窗口内的照片，
+ * 结果以 QPixmap 保存（按路径索引，插入/删除照片后仍有效），窗口外的随即释放；
+ * 每张准备好时发射 pixmapReady()，由使用者转给 SlidePage::updatePage()。
+ */
+class PhotoPageProvider : public QObject, public SlidePageProvider
+{
+    Q_OBJECT
+
+public:
+    explicit PhotoPageProvider(const QStringList &files = QStringList(), QObject *parent = nullptr);
+
+    void setFiles(const QStringList &files) { m_files = files; }
+    void insertFile(int index, const QString &path) { m_files.insert(index, path); }
+    void removeFile(int index) { m_files.removeAt(index); }
+    QStringList files() const { return m_files; }
+
+    int pageCount() const override { return m_files.count(); }
+    QWidget *createPage() override;
+    void bindPage(QWidget *page, int index) override;
+    void unbindPage(QWidget *page, int index) override;
+
+    void preparePixmaps(int current, int first, int last, const QSize &size) override;
+    QPixmap pagePixmap(int index) const override { return m_pixmaps.value(m_files.value(index)); }
+
+    /**
+     * @brief 文件内容已变化，丢弃已准备的图片（之后 SlidePage::reloadPages 会重新请求）
+     */
+    void invalidateFile(const QString &path);
+
+signals:
+    void pixmapReady(int index);   ///< 缓存图片模式下第 index 页的图片已准备好
+
+private slots:
+    void onDecoded(quint64 id, const QString &path, const QImage &image);
+
+private:
+    QStringList m_files;
+    ImageCache m_cache;                    ///< 必须在 m_decoder 之前声明（解码线程结束后才析构）
+    ImageDecodeService m_decoder;
+    QHash<quint64, QLabel *> m_requests;   ///< 未完成的请求 -> 目标页面
+    QHash<QWidget *, quint64> m_pageRequest; ///< 页面 -> 未完成的请求
+    int m_bindOrder = 0;                   ///< 绑定序号，先绑定的页面先解码
+
+    QHash<QString, QPixmap> m_pixmaps;     ///< 缓存图片模式：路径 -> 图片（解码失败为空图片）
+    QHash<QString, quint64> m_pixmapRequests; ///< 缓存图片模式：路径 -> 未完成的请求
+    QSize m_pixmapSize;                    ///< 缓存图片模式的目标尺寸
+};
+
+#endif // PHOTOPAGEPROVIDER_H
@@ -0,0 +1,103 @@
+#include "sensordashboard.h"
+
+#include <QLabel>
+#include <QLCDNumber>
+#include <QtMath>
+
+SensorDashboard::SensorDashboard(QObject *parent)
+    : QObject(parent)
+{
+    // 单次定时器：第一个脏字段出现时启动，刷新后等下一个脏字段
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    setRefreshRate(30);
+    connect(&m_timer, &QTimer::timeout, this, &SensorDashboard::flush);
+}
+
+void SensorDashboard::setRefreshRate(int hz)
+{
+    m_timer.setInterval(1000 / qBound(1, hz, 120));
+}
+
+void SensorDashboard::bind(Field field, QLCDNumber *lcd, QLabel *label,
+                           const QString &caption, const QString &unit, int decimals, double min, double max)
+{
+    if (field < 0 || field >= FieldCount)
+        return;
+
+    Entry &entry = m_fields[field];
+    entry.lcd = lcd;
+    entry.label = label;
+    entry.caption = caption;
+    entry.unit = unit;
+    entry.decimals = qBound(0, decimals, 6);
+    entry.scale = qPow(10.0, entry.decimals);
+    entry.min = min;
+    entry.max = max > min ? max : min + 1;
+    entry.shown = false;
+    entry.text.clear();
+}
+
+void SensorDashboard::setValue(Field field, double value)
+{
+    if (field < 0 || field >= FieldCount)
+        return;
+
+    m_counters.updates++;
+
+    Entry &entry = m_fields[field];
+    const qint64 valueKey = qRound64(value * entry.scale);
+    const qint64 percentKey = qRound64((value - entry.min) * 1000.0 / (entry.max - entry.min));
+
+    entry.value = value;
+    if (entry.shown && valueKey == entry.valueKey && percentKey == entry.percentKey)
+        return;   // 显示内容不变
+
+    entry.valueKey = valueKey;
+    entry.percentKey = percentKey;
+    m_dirty |= 1u << field;
+
+    if (!m_timer.isActive())
+        m_timer.start();
+}
+
+void SensorDashboard::flush()
+{
+    if (!m_dirty)
+        return;
+
+    m_counters.flushes++;
+
+    for (int field = 0; field < FieldCount; ++field) {
+        if (!(m_dirty & (1u << field)))
+            continue;
+
+        Entry &entry = m_fields[field];
+
+        if (entry.lcd && (!entry.shown || entry.valueKey != entry.shownValueKey)) {
+            if (entry.decimals == 0)
+                entry.lcd->display(static_cast<int>(entry.valueKey));
+            else
+                entry.lcd->display(entry.valueKey / entry.scale);
+            m_counters.lcdUpdates++;
+        }
+        entry.shownValueKey = entry.valueKey;
+
+        if (entry.label) {
+            const QString text = entry.caption
+                    + QString::number(entry.valueKey / entry.scale, 'f', entry.decimals)
+                    + entry.unit
+                    + QStringLiteral("\n百分比: ")
+                    + QString::number(entry.percentKey / 10.0, 'f', 1)
+                    + QLatin1Char('%');
+            if (text != entry.text) {
+                entry.label->setText(text);
+                entry.text = text;
+                m_counters.labelUpdates++;
+            }
+        }
+        entry.shown = true;
+    }
+
+    m_dirty = 0;
+}
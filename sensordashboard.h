@@ -0,0 +1,95 @@
+#ifndef SENSORDASHBOARD_H
+#define SENSORDASHBOARD_H
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+class QLabel;
+class QLCDNumber;
+
+/**
+ * @brief 传感器仪表盘（LCD 数字 + 说明文字）的合并刷新
+ *
+ * 样本到达时只调用 setValue() 记录数值：
+ * - 数值按显示精度量化，量化结果与屏幕上一致时不标脏
+ * - 脏字段由定时器按刷新率（默认 30 Hz）统一刷新，两次刷新之间的多个样本只显示最后一个
+ * - 刷新时 LCD 与文字分别比较，未变化的不调用 display()/setText()，避免无谓的重新排版
+ *
+ * 只能在GUI线程中使用。
+ */
+class SensorDashboard : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Field {
+        Als, Ps, Ir,
+        Ax, Ay, Az,
+        Gx, Gy, Gz,
+        FieldCount
+    };
+
+    /**
+     * @brief 刷新统计
+     */
+    struct Counters {
+        quint64 updates = 0;        ///< setValue() 次数
+        quint64 flushes = 0;        ///< 实际执行的刷新次数
+        quint64 lcdUpdates = 0;     ///< display() 调用次数
+        quint64 labelUpdates = 0;   ///< setText() 调用次数
+    };
+
+    explicit SensorDashboard(QObject *parent = nullptr);
+
+    /**
+     * @brief 绑定字段的显示控件
+     * @param caption 文字第一行的前缀，如 "AX: "
+     * @param unit 单位（带前导空格），如 " g"
+     * @param decimals 显示的小数位数
+     * @param min/max 百分比换算范围
+     */
+    void bind(Field field, QLCDNumber *lcd, QLabel *label,
+              const QString &caption, const QString &unit, int decimals, double min, double max);
+
+    /**
+     * @brief 更新字段数值（不立即重绘）
+     */
+    void setValue(Field field, double value);
+
+    /**
+     * @brief 设置刷新率（Hz），通常为屏幕刷新率或其一半
+     */
+    void setRefreshRate(int hz);
+
+    const Counters &counters() const { return m_counters; }
+
+public slots:
+    void flush();   ///< 立即刷新所有脏字段
+
+private:
+    struct Entry {
+        QLCDNumber *lcd = nullptr;
+        QLabel *label = nullptr;
+        QString caption;
+        QString unit;
+        int decimals = 0;
+        double scale = 1;         ///< 10^decimals
+        double min = 0;
+        double max = 1;
+
+        double value = 0;         ///< 最新数值
+        qint64 valueKey = 0;      ///< 按显示精度量化的数值
+        qint64 percentKey = 0;    ///< 百分比（0.1% 精度）
+        qint64 shownValueKey = 0; ///< 屏幕上 LCD 的数值
+        bool shown = false;       ///< 是否已显示过
+        QString text;             ///< 屏幕上的文字
+    };
+
+    Entry m_fields[FieldCount];
+    quint32 m_dirty = 0;          ///< 脏字段位图
+    QTimer m_timer;
+    Counters m_counters;
+};
+
+#endif // SENSORDASHBOARD_H
@@ -0,0 +1,191 @@
+#include "sensorhistory.h"
+
+#include <time.h>
+
+const qint64 SensorHistory::kSecondUs;
+const qint64 SensorHistory::kMinuteUs;
+
+SensorHistory::SensorHistory(int rawCapacity, int secondCapacity, int minuteCapacity)
+{
+    for (ChannelData &data : m_channels) {
+        data.raw.init(qMax(1, rawCapacity));
+        data.seconds.init(qMax(1, secondCapacity));
+        data.minutes.init(qMax(1, minuteCapacity));
+    }
+}
+
+qint64 SensorHistory::nowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+void SensorHistory::clear()
+{
+    for (ChannelData &data : m_channels) {
+        data.raw.clear();
+        data.seconds.clear();
+        data.minutes.clear();
+        data.second = Accumulator();
+        data.minute = Accumulator();
+    }
+}
+
+void SensorHistory::Accumulator::add(float minValue, float maxValue, double sumValue, quint32 n)
+{
+    if (count == 0) {
+        min = minValue;
+        max = maxValue;
+    } else {
+        min = qMin(min, minValue);
+        max = qMax(max, maxValue);
+    }
+    sum += sumValue;
+    count += n;
+}
+
+SensorHistory::Aggregate SensorHistory::Accumulator::toAggregate() const
+{
+    Aggregate a;
+    a.startUs = startUs;
+    a.min = min;
+    a.max = max;
+    a.avg = count ? static_cast<float>(sum / count) : 0.0f;
+    a.count = count;
+    return a;
+}
+
+/**
+ * @brief 当前秒结束：写入秒级缓冲区，并累加到所在分钟
+ */
+void SensorHistory::closeSecond(ChannelData &data)
+{
+    const Accumulator &second = data.second;
+    if (second.startUs < 0)
+        return;
+
+    data.seconds.push(second.toAggregate());
+
+    const qint64 minuteStart = second.startUs - second.startUs % kMinuteUs;
+    if (data.minute.startUs != minuteStart) {
+        if (data.minute.startUs >= 0)
+            data.minutes.push(data.minute.toAggregate());
+        data.minute = Accumulator();
+        data.minute.startUs = minuteStart;
+    }
+    data.minute.add(second.min, second.max, second.sum, second.count);
+
+    data.second = Accumulator();
+}
+
+void SensorHistory::add(Channel channel, qint64 timestampUs, float value)
+{
+    if (channel < 0 || channel >= ChannelCount)
+        return;
+
+    ChannelData &data = m_channels[channel];
+
+    Point point;
+    point.timestampUs = timestampUs;
+    point.value = value;
+    data.raw.push(point);
+
+    const qint64 secondStart = timestampUs - timestampUs % kSecondUs;
+    if (data.second.startUs != secondStart) {
+        closeSecond(data);
+        data.second.startUs = secondStart;
+    }
+    data.second.add(value, value, value, 1);
+}
+
+/**
+ * @brief 二分查找第一个 key(item) >= value 的位置
+ */
+template <typename T, typename Key>
+int SensorHistory::lowerBound(const Ring<T> &ring, qint64 value, Key key)
+{
+    int lo = 0;
+    int hi = ring.size();
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        if (key(ring.at(mid)) < value)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+int SensorHistory::queryRaw(Channel channel, qint64 fromUs, qint64 toUs, QVector<Point> &out) const
+{
+    if (channel < 0 || channel >= ChannelCount || fromUs > toUs)
+        return 0;
+
+    const Ring<Point> &raw = m_channels[channel].raw;
+    const int first = lowerBound(raw, fromUs, [](const Point &p) { return p.timestampUs; });
+
+    int n = 0;
+    for (int i = first; i < raw.size() && raw.at(i).timestampUs <= toUs; ++i, ++n)
+        out.append(raw.at(i));
+    return n;
+}
+
+/**
+ * @brief 追加与 [fromUs, toUs] 相交的已结束时间段
+ */
+int SensorHistory::appendAggregates(const Ring<Aggregate> &ring, qint64 periodUs,
+                                    qint64 fromUs, qint64 toUs, QVector<Aggregate> &out)
+{
+    // 时间段 [startUs, startUs + periodUs) 与查询范围相交 <=> startUs > fromUs - periodUs
+    int i = lowerBound(ring, fromUs - periodUs + 1, [](const Aggregate &a) { return a.startUs; });
+
+    int n = 0;
+    for (; i < ring.size() && ring.at(i).startUs <= toUs; ++i, ++n)
+        out.append(ring.at(i));
+    return n;
+}
+
+/**
+ * @brief 追加尚未结束的时间段
+ */
+int SensorHistory::appendOpen(const Accumulator &open, qint64 periodUs,
+                              qint64 fromUs, qint64 toUs, QVector<Aggregate> &out)
+{
+    if (open.startUs < 0 || open.startUs > toUs || open.startUs + periodUs <= fromUs)
+        return 0;
+
+    out.append(open.toAggregate());
+    return 1;
+}
+
+int SensorHistory::queryAggregates(Channel channel, Tier tier, qint64 fromUs, qint64 toUs,
+                                   QVector<Aggregate> &out) const
+{
+    if (channel < 0 || channel >= ChannelCount || fromUs > toUs)
+        return 0;
+
+    const ChannelData &data = m_channels[channel];
+    if (tier == Second) {
+        int n = appendAggregates(data.seconds, kSecondUs, fromUs, toUs, out);
+        n += appendOpen(data.second, kSecondUs, fromUs, toUs, out);
+        return n;
+    }
+
+    int n = appendAggregates(data.minutes, kMinuteUs, fromUs, toUs, out);
+
+    // 当前分钟还需要加上尚未结束的当前秒；当前秒可能已进入新的一分钟
+    const Accumulator &second = data.second;
+    Accumulator minute = data.minute;
+    if (second.startUs >= 0) {
+        const qint64 minuteStart = second.startUs - second.startUs % kMinuteUs;
+        if (minute.startUs != minuteStart) {
+            n += appendOpen(minute, kMinuteUs, fromUs, toUs, out);
+            minute = Accumulator();
+            minute.startUs = minuteStart;
+        }
+        minute.add(second.min, second.max, second.sum, second.count);
+    }
+    n += appendOpen(minute, kMinuteUs, fromUs, toUs, out);
+    return n;
+}
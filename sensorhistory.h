@@ -0,0 +1,147 @@
+#ifndef SENSORHISTORY_H
+#define SENSORHISTORY_H
+
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @brief 传感器历史数据（固定内存的时间序列）
+ *
+ * 每个通道（ALS/PS/IR 与六轴 ax..gz）保存三级数据：
+ * - 原始样本：最近 rawCapacity 个
+ * - 1 秒聚合：最近 secondCapacity 秒的 min/max/avg
+ * - 1 分钟聚合：最近 minuteCapacity 分钟的 min/max/avg
+ *
+ * 聚合在 add() 时增量完成：样本累加到当前秒，秒结束时写入秒级环形缓冲区并
+ * 累加到当前分钟。所有缓冲区在构造时一次分配，之后不再增长。
+ * 时间戳为单调时钟微秒（与 Ap3216cSample::timestampUs 一致），同一通道应按时间顺序添加。
+ *
+ * 非线程安全，应在接收样本的线程（通常是GUI线程）中使用。
+ */
+class SensorHistory
+{
+public:
+    enum Channel {
+        Als, Ps, Ir,
+        Ax, Ay, Az,
+        Gx, Gy, Gz,
+        ChannelCount
+    };
+
+    enum Tier {
+        Second,   ///< 1 秒聚合
+        Minute    ///< 1 分钟聚合
+    };
+
+    struct Point {
+        qint64 timestampUs;
+        float value;
+    };
+
+    struct Aggregate {
+        qint64 startUs;   ///< 时间段起点（按时间段长度对齐）
+        float min;
+        float max;
+        float avg;
+        quint32 count;    ///< 包含的原始样本数
+    };
+
+    explicit SensorHistory(int rawCapacity = 4096, int secondCapacity = 3600, int minuteCapacity = 1440);
+
+    /**
+     * @brief 添加一个样本
+     */
+    void add(Channel channel, qint64 timestampUs, float value);
+
+    /**
+     * @brief 查询原始样本
+     * @param fromUs/toUs 时间范围 [fromUs, toUs]
+     * @param out 输出（追加），按时间顺序
+     * @return 追加的样本数
+     */
+    int queryRaw(Channel channel, qint64 fromUs, qint64 toUs, QVector<Point> &out) const;
+
+    /**
+     * @brief 查询聚合数据，包含尚未结束的当前时间段
+     * @return 追加的时间段数
+     */
+    int queryAggregates(Channel channel, Tier tier, qint64 fromUs, qint64 toUs,
+                        QVector<Aggregate> &out) const;
+
+    /**
+     * @brief 清空所有通道（不释放内存）
+     */
+    void clear();
+
+    static qint64 nowUs();   ///< 单调时钟，微秒
+
+    static const qint64 kSecondUs = 1000000;
+    static const qint64 kMinuteUs = 60 * kSecondUs;
+
+private:
+    /**
+     * @brief 固定容量环形缓冲区，满后覆盖最旧元素
+     */
+    template <typename T>
+    class Ring {
+    public:
+        void init(int capacity) { m_items.resize(capacity); m_start = 0; m_size = 0; }
+        void clear() { m_start = 0; m_size = 0; }
+        int size() const { return m_size; }
+        const T &at(int i) const { return m_items.at((m_start + i) % m_items.size()); } ///< 0 为最旧
+
+        void push(const T &item)
+        {
+            if (m_size < m_items.size()) {
+                m_items[(m_start + m_size) % m_items.size()] = item;
+                m_size++;
+            } else {
+                m_items[m_start] = item;
+                m_start = (m_start + 1) % m_items.size();
+            }
+        }
+
+    private:
+        QVector<T> m_items;
+        int m_start = 0;
+        int m_size = 0;
+    };
+
+    /**
+     * @brief 正在累加的时间段
+     */
+    struct Accumulator {
+        qint64 startUs = -1;   ///< -1 表示空
+        float min = 0;
+        float max = 0;
+        double sum = 0;
+        quint32 count = 0;
+
+        void add(float minValue, float maxValue, double sumValue, quint32 n);
+        Aggregate toAggregate() const;
+    };
+
+    struct ChannelData {
+        Ring<Point> raw;
+        Ring<Aggregate> seconds;
+        Ring<Aggregate> minutes;
+        Accumulator second;
+        Accumulator minute;
+    };
+
+    void closeSecond(ChannelData &data);
+    static int appendAggregates(const Ring<Aggregate> &ring, qint64 periodUs,
+                                qint64 fromUs, qint64 toUs, QVector<Aggregate> &out);
+    static int appendOpen(const Accumulator &open, qint64 periodUs,
+                          qint64 fromUs, qint64 toUs, QVector<Aggregate> &out);
+
+    template <typename T, typename Key>
+    static int lowerBound(const Ring<T> &ring, qint64 value, Key key);
+
+    ChannelData m_channels[ChannelCount];
+};
+
+Q_DECLARE_TYPEINFO(SensorHistory::Point, Q_PRIMITIVE_TYPE);
+Q_DECLARE_TYPEINFO(SensorHistory::Aggregate, Q_PRIMITIVE_TYPE);
+
+#endif // SENSORHISTORY_H
@@ -0,0 +1,353 @@
+#include "sensorlog.h"
+#include "crc16.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+int64_t sensorLogRealtimeUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+static const SensorLogRecord *blockRecords(const uint8_t *block)
+{
+    return reinterpret_cast<const SensorLogRecord *>(block + sizeof(SensorLogBlockHeader));
+}
+
+/* ================= 读取 ================= */
+
+std::string SensorLogReader::segmentPath(const std::string &dir, uint32_t segment)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "/sensor-%08u.slog", segment);
+    return dir + name;
+}
+
+std::vector<uint32_t> SensorLogReader::listSegments(const char *dir)
+{
+    std::vector<uint32_t> segments;
+
+    DIR *d = opendir(dir);
+    if (!d)
+        return segments;
+
+    while (struct dirent *entry = readdir(d)) {
+        unsigned segment;
+        char tail;
+        // 严格匹配 sensor-XXXXXXXX.slog
+        if (strlen(entry->d_name) == 20 &&
+            sscanf(entry->d_name, "sensor-%8u.slo%c", &segment, &tail) == 2 && tail == 'g')
+            segments.push_back(segment);
+    }
+    closedir(d);
+
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+/**
+ * @brief 写入方先写记录、再写 CRC、最后写记录数，
+ *        所以有效记录数是 [0, recordCount+1] 中 CRC 匹配的最长前缀
+ */
+int SensorLogReader::validRecords(const uint8_t *block, uint32_t segment)
+{
+    SensorLogBlockHeader header;
+    memcpy(&header, block, sizeof(header));
+    if (header.magic != SENSOR_LOG_BLOCK_MAGIC || header.segment != segment)
+        return -1;
+
+    const int limit = std::min<int>(header.recordCount + 1, SENSOR_LOG_RECORDS_PER_BLOCK);
+
+    uint16_t prefix[SENSOR_LOG_RECORDS_PER_BLOCK + 1];
+    prefix[0] = CRC16_MODBUS_INIT;
+    const uint8_t *p = block + sizeof(SensorLogBlockHeader);
+    for (int i = 0; i < limit; i++)
+        prefix[i + 1] = crc16_modbus(p + i * sizeof(SensorLogRecord), sizeof(SensorLogRecord), prefix[i]);
+
+    for (int n = limit; n >= 0; n--) {
+        if (prefix[n] == header.crc)
+            return n;
+    }
+    return -1;
+}
+
+size_t SensorLogReader::scan(const char *dir, int64_t fromUs, int64_t toUs, uint16_t type,
+                             std::vector<SensorLogRecord> &out)
+{
+    size_t appended = 0;
+
+    for (uint32_t segment : listSegments(dir)) {
+        const std::string path = segmentPath(dir, segment);
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            continue;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < SENSOR_LOG_BLOCK_SIZE) {
+            ::close(fd);
+            continue;
+        }
+
+        const size_t size = static_cast<size_t>(st.st_size) / SENSOR_LOG_BLOCK_SIZE * SENSOR_LOG_BLOCK_SIZE;
+        void *map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED)
+            continue;
+
+        const uint8_t *base = static_cast<const uint8_t *>(map);
+        for (size_t offset = 0; offset < size; offset += SENSOR_LOG_BLOCK_SIZE) {
+            const uint8_t *block = base + offset;
+
+            // 先按块头记录数粗略判断时间范围，不相交的块不做 CRC 校验
+            SensorLogBlockHeader header;
+            memcpy(&header, block, sizeof(header));
+            if (header.magic != SENSOR_LOG_BLOCK_MAGIC)
+                break;   // 段内其余块尚未使用
+
+            const SensorLogRecord *records = blockRecords(block);
+            const int hinted = std::min<int>(header.recordCount, SENSOR_LOG_RECORDS_PER_BLOCK);
+            if (hinted > 0) {
+                if (records[0].timestampUs > toUs)
+                    continue;
+                // 块未满时第 hinted 条可能是 CRC 已提交但尚未计数的记录
+                if (records[hinted - 1].timestampUs < fromUs &&
+                    (hinted == static_cast<int>(SENSOR_LOG_RECORDS_PER_BLOCK) ||
+                     records[hinted].timestampUs < fromUs))
+                    continue;
+            }
+
+            const int n = validRecords(block, segment);
+            for (int i = 0; i < n; i++) {
+                const SensorLogRecord &record = records[i];
+                if (record.timestampUs < fromUs || record.timestampUs > toUs)
+                    continue;
+                if (type != 0 && record.type != type)
+                    continue;
+                out.push_back(record);
+                appended++;
+            }
+        }
+
+        munmap(map, size);
+    }
+    return appended;
+}
+
+/* ================= 写入 ================= */
+
+SensorLogWriter::SensorLogWriter()
+    : m_blocksPerSegment(256), m_maxSegments(64),
+      m_fd(-1), m_map(nullptr), m_segment(0), m_block(0), m_blockOpen(false), m_records(0)
+{
+}
+
+SensorLogWriter::~SensorLogWriter()
+{
+    close();
+}
+
+SensorLogBlockHeader *SensorLogWriter::header() const
+{
+    return reinterpret_cast<SensorLogBlockHeader *>(m_map + static_cast<size_t>(m_block) * SENSOR_LOG_BLOCK_SIZE);
+}
+
+bool SensorLogWriter::open(const char *dir, uint32_t blocksPerSegment, uint32_t maxSegments)
+{
+    close();
+
+    m_dir = dir;
+    m_blocksPerSegment = std::max<uint32_t>(1, blocksPerSegment);
+    m_maxSegments = maxSegments;
+    m_records = 0;
+
+    const std::vector<uint32_t> segments = SensorLogReader::listSegments(dir);
+    if (!segments.empty() && openSegment(segments.back(), true))
+        return true;
+
+    return openSegment(segments.empty() ? 1 : segments.back() + 1, false);
+}
+
+/**
+ * @brief 打开（或创建）段文件并映射
+ * @param resume true=定位到最后一个有效块继续追加
+ */
+bool SensorLogWriter::openSegment(uint32_t segment, bool resume)
+{
+    const std::string path = SensorLogReader::segmentPath(m_dir, segment);
+    const size_t size = static_cast<size_t>(m_blocksPerSegment) * SENSOR_LOG_BLOCK_SIZE;
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC | (resume ? 0 : O_CREAT | O_EXCL), 0644);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (resume && static_cast<size_t>(st.st_size) != size)) {
+        // 段大小与当前配置不同，不在其中继续追加
+        ::close(fd);
+        return false;
+    }
+
+    // 预分配，避免写入时才分配存储导致碎片和 SIGBUS
+    if (!resume && posix_fallocate(fd, 0, static_cast<off_t>(size)) != 0 &&
+        ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        unlink(path.c_str());
+        return false;
+    }
+
+    void *map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_map = static_cast<uint8_t *>(map);
+    m_segment = segment;
+    m_block = 0;
+    m_blockOpen = false;
+
+    if (resume) {
+        // 找到第一个未使用的块；前一块未写满时在其中继续
+        uint32_t used = 0;
+        while (used < m_blocksPerSegment &&
+               reinterpret_cast<const SensorLogBlockHeader *>(m_map + static_cast<size_t>(used) * SENSOR_LOG_BLOCK_SIZE)->magic
+                   == SENSOR_LOG_BLOCK_MAGIC)
+            used++;
+
+        if (used > 0) {
+            m_block = used - 1;
+            const int n = SensorLogReader::validRecords(m_map + static_cast<size_t>(m_block) * SENSOR_LOG_BLOCK_SIZE, segment);
+            if (n >= 0 && n < static_cast<int>(SENSOR_LOG_RECORDS_PER_BLOCK)) {
+                // 把块头修正为校验通过的状态
+                SensorLogBlockHeader *h = header();
+                uint16_t crc = CRC16_MODBUS_INIT;
+                crc = crc16_modbus(reinterpret_cast<const uint8_t *>(h + 1), n * sizeof(SensorLogRecord), crc);
+                h->crc = crc;
+                h->recordCount = static_cast<uint16_t>(n);
+                m_blockOpen = true;
+            } else {
+                m_block = used;
+            }
+        }
+
+        if (!m_blockOpen && m_block >= m_blocksPerSegment) {
+            // 段已写满，换新段
+            closeSegment();
+            return openSegment(segment + 1, false);
+        }
+    } else {
+        removeOldSegments();
+    }
+    return true;
+}
+
+void SensorLogWriter::closeSegment()
+{
+    if (!m_map)
+        return;
+
+    const size_t size = static_cast<size_t>(m_blocksPerSegment) * SENSOR_LOG_BLOCK_SIZE;
+    msync(m_map, size, MS_ASYNC);
+    munmap(m_map, size);
+    ::close(m_fd);
+    m_map = nullptr;
+    m_fd = -1;
+    m_blockOpen = false;
+}
+
+void SensorLogWriter::close()
+{
+    if (!m_map)
+        return;
+
+    sync();
+    closeSegment();
+}
+
+void SensorLogWriter::sync()
+{
+    if (!m_map)
+        return;
+
+    msync(m_map, static_cast<size_t>(m_blocksPerSegment) * SENSOR_LOG_BLOCK_SIZE, MS_SYNC);
+}
+
+/**
+ * @brief 初始化当前块的块头，magic 最后写入
+ */
+void SensorLogWriter::beginBlock()
+{
+    SensorLogBlockHeader *h = header();
+    h->segment = m_segment;
+    h->recordCount = 0;
+    h->crc = CRC16_MODBUS_INIT;
+    h->reserved = 0;
+    std::atomic_thread_fence(std::memory_order_release);
+    h->magic = SENSOR_LOG_BLOCK_MAGIC;
+    m_blockOpen = true;
+}
+
+bool SensorLogWriter::append(const SensorLogRecord &record)
+{
+    if (!m_map)
+        return false;
+
+    if (!m_blockOpen) {
+        if (m_block >= m_blocksPerSegment) {
+            const uint32_t next = m_segment + 1;
+            closeSegment();
+            if (!openSegment(next, false))
+                return false;
+        }
+        beginBlock();
+    }
+
+    SensorLogBlockHeader *h = header();
+    uint8_t *slot = reinterpret_cast<uint8_t *>(h + 1) + static_cast<size_t>(h->recordCount) * sizeof(SensorLogRecord);
+
+    // 记录 -> CRC -> 记录数，读取方据此丢弃半写的记录
+    memcpy(slot, &record, sizeof(record));
+    std::atomic_thread_fence(std::memory_order_release);
+    h->crc = crc16_modbus(slot, sizeof(record), h->crc);
+    std::atomic_thread_fence(std::memory_order_release);
+    h->recordCount++;
+    m_records++;
+
+    if (h->recordCount >= SENSOR_LOG_RECORDS_PER_BLOCK) {
+        // 块已满：异步回写这一页，之后不再修改
+        msync(h, SENSOR_LOG_BLOCK_SIZE, MS_ASYNC);
+        m_block++;
+        m_blockOpen = false;
+    }
+    return true;
+}
+
+/**
+ * @brief 段数超过上限时删除最旧的段
+ */
+void SensorLogWriter::removeOldSegments()
+{
+    if (m_maxSegments == 0)
+        return;
+
+    std::vector<uint32_t> segments = SensorLogReader::listSegments(m_dir.c_str());
+    size_t count = segments.size();
+    for (uint32_t segment : segments) {
+        if (count <= m_maxSegments || segment == m_segment)
+            break;
+        unlink(SensorLogReader::segmentPath(m_dir, segment).c_str());
+        count--;
+    }
+}
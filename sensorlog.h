@@ -0,0 +1,146 @@
+#ifndef SENSORLOG_H
+#define SENSORLOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * 传感器日志格式（二进制，小端，只追加）
+ *
+ *   目录下按序号命名的段文件：sensor-00000001.slog、sensor-00000002.slog ...
+ *   段文件 : 固定 blocksPerSegment 个 4096 字节块，创建时预分配
+ *   块     : SensorLogBlockHeader（16 字节） + 最多 102 条 SensorLogRecord（40 字节）
+ *
+ * 崩溃安全：
+ * - 写入方通过 mmap(MAP_SHARED) 追加，进程崩溃后数据仍在页缓存中
+ * - 每条记录先写入数据，再更新块 CRC，最后更新记录数；
+ *   读取方在 [0, 记录数+1] 中找出 CRC 匹配的最长前缀，半写的记录被丢弃
+ * - 块写满或段轮换时 msync(MS_ASYNC)，关闭时 msync(MS_SYNC)，
+ *   不逐条刷写，减少 eMMC 写放大
+ */
+
+#define SENSOR_LOG_BLOCK_MAGIC 0x42474C53u   // "SLGB"
+#define SENSOR_LOG_BLOCK_SIZE  4096
+
+enum SensorLogRecordType {
+    SensorLogAp3216c = 1,   ///< values[0..2] = als, ps, ir
+    SensorLogImu     = 2    ///< values[0..5] = ax, ay, az (g), gx, gy, gz (°/s)
+};
+
+#pragma pack(push, 1)
+struct SensorLogBlockHeader {
+    uint32_t magic;          ///< SENSOR_LOG_BLOCK_MAGIC，未使用的块为 0
+    uint32_t segment;        ///< 所属段序号，用于识别错位的块
+    uint16_t recordCount;    ///< 已提交的记录数
+    uint16_t crc;            ///< 前 recordCount 条记录的 CRC16/Modbus
+    uint32_t reserved;
+};
+
+struct SensorLogRecord {
+    int64_t timestampUs;     ///< 墙钟时间（CLOCK_REALTIME，微秒）
+    uint16_t type;           ///< SensorLogRecordType
+    uint16_t flags;
+    uint32_t reserved;
+    float values[6];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(SensorLogBlockHeader) == 16, "SensorLogBlockHeader 必须为 16 字节");
+static_assert(sizeof(SensorLogRecord) == 40, "SensorLogRecord 必须为 40 字节");
+
+#define SENSOR_LOG_RECORDS_PER_BLOCK \
+    ((SENSOR_LOG_BLOCK_SIZE - sizeof(SensorLogBlockHeader)) / sizeof(SensorLogRecord))
+
+/**
+ * @brief 传感器日志写入器
+ *
+ * 非线程安全，应在产生样本的线程中使用。追加一条记录只有内存拷贝和一次增量 CRC，
+ * 不产生系统调用（块写满时一次 msync，段写满时轮换文件）。
+ */
+class SensorLogWriter
+{
+public:
+    SensorLogWriter();
+    ~SensorLogWriter();
+
+    /**
+     * @brief 打开日志目录，从最后一个段的最后一个有效块继续追加
+     * @param dir 日志目录（必须已存在）
+     * @param blocksPerSegment 每个段文件的块数（默认 256 块 = 1 MiB）
+     * @param maxSegments 保留的段文件数，超过时删除最旧的段（0 = 不删除）
+     */
+    bool open(const char *dir, uint32_t blocksPerSegment = 256, uint32_t maxSegments = 64);
+    void close();
+    bool isOpen() const { return m_map != nullptr; }
+
+    /**
+     * @brief 追加一条记录
+     */
+    bool append(const SensorLogRecord &record);
+
+    /**
+     * @brief 把已写入的数据同步到存储（阻塞）
+     */
+    void sync();
+
+    uint64_t recordCount() const { return m_records; }   ///< 本次打开后追加的记录数
+
+private:
+    bool openSegment(uint32_t segment, bool resume);
+    void closeSegment();
+    void beginBlock();
+    SensorLogBlockHeader *header() const;
+    void removeOldSegments();
+
+    std::string m_dir;
+    uint32_t m_blocksPerSegment;
+    uint32_t m_maxSegments;
+
+    int m_fd;
+    uint8_t *m_map;              ///< 当前段的映射
+    uint32_t m_segment;          ///< 当前段序号
+    uint32_t m_block;            ///< 当前块在段内的下标
+    bool m_blockOpen;            ///< 当前块已写入块头且未写满
+    uint64_t m_records;
+};
+
+/**
+ * @brief 传感器日志读取器
+ *
+ * 只读映射段文件，按时间范围扫描，不做任何文本解析。
+ */
+class SensorLogReader
+{
+public:
+    /**
+     * @brief 扫描 [fromUs, toUs] 内的记录
+     * @param dir 日志目录
+     * @param type 记录类型，0 表示全部
+     * @param out 输出（追加），按写入顺序
+     * @return 追加的记录数
+     */
+    static size_t scan(const char *dir, int64_t fromUs, int64_t toUs, uint16_t type,
+                       std::vector<SensorLogRecord> &out);
+
+    /**
+     * @brief 校验一个块并返回有效记录数（CRC 匹配的最长前缀）
+     * @return 块未使用或损坏返回 -1
+     */
+    static int validRecords(const uint8_t *block, uint32_t segment);
+
+    /**
+     * @brief 列出目录中的段序号（升序）
+     */
+    static std::vector<uint32_t> listSegments(const char *dir);
+
+    static std::string segmentPath(const std::string &dir, uint32_t segment);
+};
+
+/**
+ * @brief 墙钟时间（微秒）
+ */
+int64_t sensorLogRealtimeUs();
+
+#endif // SENSORLOG_H
@@ -0,0 +1,165 @@
+#include "serialcapture.h"
+
+#include <cstring>
+#include <ctime>
+
+#include <sys/stat.h>
+
+uint64_t serialCaptureMonotonicNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static uint64_t realtimeNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/* ================= 写入 ================= */
+
+SerialCaptureWriter::SerialCaptureWriter()
+    : m_file(nullptr), m_startNs(0), m_records(0)
+{
+}
+
+SerialCaptureWriter::~SerialCaptureWriter()
+{
+    close();
+}
+
+/**
+ * @brief 创建抓包文件并写入文件头
+ */
+bool SerialCaptureWriter::open(const char *path)
+{
+    close();
+
+    m_file = fopen(path, "wb");
+    if (!m_file)
+        return false;
+
+    // 256 KiB 用户态缓冲，高速收发时也很少触发 write
+    m_buffer.resize(256 * 1024);
+    setvbuf(m_file, m_buffer.data(), _IOFBF, m_buffer.size());
+
+    SerialCaptureFileHeader header;
+    memcpy(header.magic, SERIAL_CAPTURE_MAGIC, 4);
+    header.version = SERIAL_CAPTURE_VERSION;
+    header.headerSize = sizeof(SerialCaptureFileHeader);
+    header.startRealtimeNs = realtimeNs();
+
+    if (fwrite(&header, sizeof(header), 1, m_file) != 1) {
+        close();
+        return false;
+    }
+
+    m_startNs = serialCaptureMonotonicNs();
+    m_records = 0;
+    return true;
+}
+
+void SerialCaptureWriter::close()
+{
+    if (m_file) {
+        fclose(m_file);   // 同时刷新缓冲区
+        m_file = nullptr;
+    }
+}
+
+void SerialCaptureWriter::record(SerialCaptureDirection direction, const void *data, uint32_t length)
+{
+    if (!m_file || length == 0)
+        return;
+
+    SerialCaptureRecordHeader rec;
+    rec.timestampNs = serialCaptureMonotonicNs() - m_startNs;
+    rec.length = length;
+    rec.direction = static_cast<uint8_t>(direction);
+    memset(rec.reserved, 0, sizeof(rec.reserved));
+
+    fwrite(&rec, sizeof(rec), 1, m_file);
+    fwrite(data, 1, length, m_file);
+    m_records++;
+}
+
+/* ================= 读取 ================= */
+
+SerialCaptureReader::SerialCaptureReader()
+    : m_file(nullptr), m_fileSize(0)
+{
+    memset(&m_header, 0, sizeof(m_header));
+}
+
+SerialCaptureReader::~SerialCaptureReader()
+{
+    close();
+}
+
+/**
+ * @brief 打开抓包文件并校验文件头
+ */
+bool SerialCaptureReader::open(const char *path)
+{
+    close();
+
+    m_file = fopen(path, "rb");
+    if (!m_file)
+        return false;
+
+    if (fread(&m_header, sizeof(m_header), 1, m_file) != 1 ||
+        memcmp(m_header.magic, SERIAL_CAPTURE_MAGIC, 4) != 0 ||
+        m_header.version != SERIAL_CAPTURE_VERSION ||
+        m_header.headerSize < sizeof(SerialCaptureFileHeader)) {
+        close();
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fileno(m_file), &st) != 0) {
+        close();
+        return false;
+    }
+    m_fileSize = static_cast<uint64_t>(st.st_size);
+
+    return rewind();
+}
+
+void SerialCaptureReader::close()
+{
+    if (m_file) {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool SerialCaptureReader::rewind()
+{
+    return m_file && fseek(m_file, m_header.headerSize, SEEK_SET) == 0;
+}
+
+bool SerialCaptureReader::next(Record &record)
+{
+    if (!m_file)
+        return false;
+
+    SerialCaptureRecordHeader rec;
+    if (fread(&rec, sizeof(rec), 1, m_file) != 1)
+        return false;
+
+    // 损坏的长度字段不能导致巨大的内存分配：长度不得超过文件剩余字节
+    const off_t pos = ftello(m_file);
+    if (pos < 0 || static_cast<uint64_t>(pos) > m_fileSize ||
+        rec.length > m_fileSize - static_cast<uint64_t>(pos))
+        return false;
+
+    record.timestampNs = rec.timestampNs;
+    record.direction = rec.direction == SerialCaptureTx ? SerialCaptureTx : SerialCaptureRx;
+    record.data.resize(rec.length);
+
+    // 最后一条记录可能因异常退出而不完整
+    return rec.length == 0 || fread(record.data.data(), 1, rec.length, m_file) == rec.length;
+}
@@ -0,0 +1,114 @@
+#ifndef SERIALCAPTURE_H
+#define SERIALCAPTURE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/*
+ * 串口收发抓包格式（二进制，小端）
+ *
+ *   文件头  : SerialCaptureFileHeader（16 字节）
+ *   记录 *N : SerialCaptureRecordHeader（16 字节） + length 字节数据
+ *
+ * 记录时间戳为相对抓包开始的单调时钟纳秒数，方向区分收/发，
+ * 可由 tools/serial_replay 通过伪终端按原始节奏回放。
+ */
+
+#define SERIAL_CAPTURE_MAGIC   "SCAP"
+#define SERIAL_CAPTURE_VERSION 1
+
+enum SerialCaptureDirection {
+    SerialCaptureRx = 0,   ///< 设备 -> 本机
+    SerialCaptureTx = 1    ///< 本机 -> 设备
+};
+
+#pragma pack(push, 1)
+struct SerialCaptureFileHeader {
+    char magic[4];             ///< "SCAP"
+    uint16_t version;          ///< 格式版本
+    uint16_t headerSize;       ///< 文件头长度，便于以后扩展
+    uint64_t startRealtimeNs;  ///< 抓包开始的墙钟时间（纳秒）
+};
+
+struct SerialCaptureRecordHeader {
+    uint64_t timestampNs;      ///< 相对抓包开始的时间（单调时钟）
+    uint32_t length;           ///< 数据长度
+    uint8_t direction;         ///< SerialCaptureDirection
+    uint8_t reserved[3];
+};
+#pragma pack(pop)
+
+/**
+ * @brief 抓包写入器
+ *
+ * 非线程安全，应在串口 I/O 所在线程中使用。写入经过大块用户态缓冲，
+ * 每条记录只有两次内存拷贝，不产生系统调用。
+ */
+class SerialCaptureWriter
+{
+public:
+    SerialCaptureWriter();
+    ~SerialCaptureWriter();
+
+    bool open(const char *path);
+    void close();
+    bool isOpen() const { return m_file != nullptr; }
+
+    /**
+     * @brief 追加一条记录
+     */
+    void record(SerialCaptureDirection direction, const void *data, uint32_t length);
+
+    uint64_t recordCount() const { return m_records; }
+
+private:
+    FILE *m_file;
+    uint64_t m_startNs;
+    uint64_t m_records;
+    std::vector<char> m_buffer;   ///< stdio 缓冲区
+};
+
+/**
+ * @brief 抓包读取器
+ */
+class SerialCaptureReader
+{
+public:
+    struct Record {
+        uint64_t timestampNs = 0;
+        SerialCaptureDirection direction = SerialCaptureRx;
+        std::vector<uint8_t> data;
+    };
+
+    SerialCaptureReader();
+    ~SerialCaptureReader();
+
+    bool open(const char *path);
+    void close();
+
+    /**
+     * @brief 回到第一条记录
+     */
+    bool rewind();
+
+    /**
+     * @brief 读取下一条记录
+     * @return false=文件结束或格式错误（记录长度超出文件剩余字节时不分配缓冲区，直接失败）
+     */
+    bool next(Record &record);
+
+    const SerialCaptureFileHeader &header() const { return m_header; }
+
+private:
+    FILE *m_file;
+    SerialCaptureFileHeader m_header;
+    uint64_t m_fileSize;   ///< 打开时的文件大小，用于校验记录长度
+};
+
+/**
+ * @brief 单调时钟（纳秒）
+ */
+uint64_t serialCaptureMonotonicNs();
+
+#endif // SERIALCAPTURE_H
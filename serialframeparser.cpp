@@ -0,0 +1,120 @@
+#include "serialframeparser.h"
+#include "crc16.h"
+
+#include <cstring>
+
+const size_t SerialFrameParser::kRingCapacity;
+const size_t SerialFrameParser::kMaxFrameSize;
+const size_t SerialFrameParser::kFrameOverhead;
+
+SerialFrameParser::SerialFrameParser()
+{
+    static_assert((kRingCapacity & (kRingCapacity - 1)) == 0, "kRingCapacity 必须为 2 的幂");
+    static_assert(kMaxFrameSize <= kRingCapacity, "最大帧长不能超过环形缓冲区容量");
+    static_assert(kMaxFrameSize - kFrameOverhead <= 0xFFFF - 2, "最大帧长超出 16 位长度字段");
+}
+
+/**
+ * @brief 写入原始字节到环形缓冲区
+ */
+size_t SerialFrameParser::push(const uint8_t *data, size_t size)
+{
+    size_t space = kRingCapacity - buffered();
+    if (size > space)
+        size = space;
+    if (size == 0)
+        return 0;
+
+    // 最多分两段拷贝（尾部 + 回绕到头部）
+    size_t pos = m_tail & (kRingCapacity - 1);
+    size_t first = kRingCapacity - pos;
+    if (first > size)
+        first = size;
+    memcpy(m_ring + pos, data, first);
+    memcpy(m_ring, data + first, size - first);
+
+    m_tail += size;
+    return size;
+}
+
+/**
+ * @brief 从读位置拷贝 size 字节到线性帧缓冲区
+ */
+void SerialFrameParser::copyOut(uint8_t *dst, size_t size) const
+{
+    size_t pos = m_head & (kRingCapacity - 1);
+    size_t first = kRingCapacity - pos;
+    if (first > size)
+        first = size;
+    memcpy(dst, m_ring + pos, first);
+    memcpy(dst + first, m_ring, size - first);
+}
+
+/**
+ * @brief 解析下一帧
+ */
+bool SerialFrameParser::next(Frame &frame)
+{
+    for (;;) {
+        // 1. 查找帧头 AA AA，丢弃之前的无效字节
+        while (buffered() >= 2 && !(at(0) == 0xAA && at(1) == 0xAA)) {
+            drop(1);
+            m_droppedBytes++;
+        }
+
+        // 2. 读取长度字段
+        if (buffered() < 4)
+            return false;
+
+        size_t len = (static_cast<size_t>(at(2)) << 8) | at(3);
+        size_t frameSize = len + 6;
+        if (len < 2 || frameSize > kMaxFrameSize) {
+            // 长度非法，说明不是真正的帧头，跳过一个字节重新同步
+            m_lengthErrors++;
+            m_droppedBytes++;
+            drop(1);
+            continue;
+        }
+
+        // 3. 等待整帧到齐
+        if (buffered() < frameSize)
+            return false;
+
+        copyOut(m_frame, frameSize);
+
+        // 4. CRC 校验（与 packCommand 一致：从长度字段开始计算 len 字节）
+        uint16_t crcCalc = crc16_modbus(m_frame + 2, len);
+        uint16_t crcRecv = m_frame[len + 4] | (m_frame[len + 5] << 8);
+        if (crcCalc != crcRecv) {
+            m_crcErrors++;
+            m_droppedBytes++;
+            drop(1);
+            continue;
+        }
+
+        drop(frameSize);
+        m_framesOk++;
+
+        frame.cmd = static_cast<uint16_t>((m_frame[4] << 8) | m_frame[5]);
+        frame.payload = m_frame + 6;
+        frame.payloadSize = static_cast<uint16_t>(len - 2);
+        return true;
+    }
+}
+
+/**
+ * @brief 清空缓冲区
+ */
+void SerialFrameParser::reset()
+{
+    m_head = 0;
+    m_tail = 0;
+}
+
+void SerialFrameParser::resetCounters()
+{
+    m_framesOk = 0;
+    m_crcErrors = 0;
+    m_lengthErrors = 0;
+    m_droppedBytes = 0;
+}
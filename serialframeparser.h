@@ -0,0 +1,86 @@
+#ifndef SERIALFRAMEPARSER_H
+#define SERIALFRAMEPARSER_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 串口帧流式解析器
+ *
+ * 帧格式与 serialModule::packCommand() 一致：
+ *   AA AA | 长度(2, 高字节在前) | 指令(2, 高字节在前) | 扩展数据 | CRC16(2, 低字节在前)
+ * 其中 长度 = 2 + 扩展数据长度，CRC 从长度字段开始计算 长度 个字节。
+ *
+ * 特点：
+ * - 固定容量环形缓冲区，运行期间不做任何堆分配
+ * - 数据可以任意拆分/合并地喂入，按帧头 AA AA 自动重新同步
+ * - 校验长度与 CRC，错误帧丢弃并计数
+ */
+class SerialFrameParser
+{
+public:
+    static const size_t kRingCapacity = 8192;   ///< 环形缓冲区容量（必须为 2 的幂）
+    static const size_t kMaxFrameSize = 4096;   ///< 允许的最大整帧长度（发送端 serialModule::kMaxPayloadSize 由此得出）
+    static const size_t kFrameOverhead = 8;     ///< 帧头(2)+长度(2)+指令(2)+CRC(2)
+
+    /**
+     * @brief 解析出的一帧数据，payload 指向解析器内部缓冲区，
+     *        在下一次调用 push()/next() 之前有效
+     */
+    struct Frame {
+        uint16_t cmd = 0;                ///< 控制指令
+        const uint8_t *payload = nullptr; ///< 扩展数据
+        uint16_t payloadSize = 0;        ///< 扩展数据长度
+    };
+
+    SerialFrameParser();
+
+    /**
+     * @brief 写入接收到的原始字节
+     * @return 实际写入的字节数，缓冲区满时可能小于 size，
+     *         调用者应先 next() 取走帧后再写入剩余部分
+     */
+    size_t push(const uint8_t *data, size_t size);
+
+    /**
+     * @brief 尝试解析下一帧
+     * @param frame 输出帧
+     * @return true=解析到完整且校验通过的一帧，false=数据不足
+     */
+    bool next(Frame &frame);
+
+    /**
+     * @brief 清空缓冲区（不清除统计计数）
+     */
+    void reset();
+
+    /**
+     * @brief 清零统计计数（不影响缓冲区）
+     */
+    void resetCounters();
+
+    size_t buffered() const { return m_tail - m_head; } ///< 缓冲区内待解析字节数
+
+    // ================= 统计 =================
+    uint64_t framesOk() const { return m_framesOk; }         ///< 校验通过的帧数
+    uint64_t crcErrors() const { return m_crcErrors; }       ///< CRC 错误帧数
+    uint64_t lengthErrors() const { return m_lengthErrors; } ///< 长度非法次数
+    uint64_t droppedBytes() const { return m_droppedBytes; } ///< 重新同步时丢弃的字节数
+
+private:
+    uint8_t at(size_t offset) const { return m_ring[(m_head + offset) & (kRingCapacity - 1)]; }
+    void copyOut(uint8_t *dst, size_t size) const;
+    void drop(size_t size) { m_head += size; }
+
+    uint8_t m_ring[kRingCapacity];   ///< 环形缓冲区
+    uint8_t m_frame[kMaxFrameSize];  ///< 当前帧的线性拷贝（处理回绕）
+    size_t m_head = 0;               ///< 读位置（自由增长，取模使用）
+    size_t m_tail = 0;               ///< 写位置（自由增长，取模使用）
+
+    uint64_t m_framesOk = 0;
+    uint64_t m_crcErrors = 0;
+    uint64_t m_lengthErrors = 0;
+    uint64_t m_droppedBytes = 0;
+};
+
+#endif // SERIALFRAMEPARSER_H
@@ -0,0 +1,358 @@
+#include "serialioworker.h"
+
+#include <QMutexLocker>
+#include <QFile>
+
+#ifdef Q_OS_LINUX
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+#endif
+
+const qint64 SerialIoWorker::kTxHighWatermark;
+const qint64 SerialIoWorker::kTxLowWatermark;
+
+SerialIoWorker::SerialIoWorker(SerialStats *stats, QObject *parent)
+    : QObject(parent),
+      m_stats(stats),
+      m_open(false),
+      m_rawForwarding(true),
+      m_rxPending(false),
+      m_txFlushScheduled(false),
+      m_txOutstanding(0)
+{
+    // 预留容量，之后两个缓冲区交换使用，resize(0) 不释放内存
+    m_txPending.reserve(4096);
+    m_txWriting.reserve(4096);
+
+    m_clock.start();
+
+    // 串口对象作为子对象，moveToThread 时一起移动
+    m_serial = new QSerialPort(this);
+
+    connect(m_serial, &QSerialPort::readyRead, this, &SerialIoWorker::readSerialData);
+    connect(m_serial, &QSerialPort::errorOccurred, this, &SerialIoWorker::handleError);
+    connect(m_serial, &QSerialPort::bytesWritten, this, &SerialIoWorker::onPortBytesWritten);
+}
+
+SerialIoWorker::~SerialIoWorker()
+{
+    closePort();
+}
+
+/**
+ * @brief 打开串口并设置参数
+ */
+bool SerialIoWorker::openPort(const QString &portName, const serialModule::SerialConfig &config)
+{
+    if (m_serial->isOpen()) {
+        m_serial->close();
+    }
+
+    m_serial->setPortName(portName);
+    if (!m_serial->open(QIODevice::ReadWrite)) {
+        m_open.store(false, std::memory_order_release);
+        return false;
+    }
+
+    m_serial->setBaudRate(config.baudRate);
+    m_serial->setDataBits(config.dataBits);
+    m_serial->setParity(config.parity);
+    m_serial->setStopBits(config.stopBits);
+    m_serial->setFlowControl(config.flowControl);
+
+    m_serial->setDataTerminalReady(config.dtrEnabled);
+    m_serial->setRequestToSend(config.rtsEnabled);
+
+    // 新连接丢弃上一次残留的半帧
+    m_frameParser.reset();
+    m_uartOverrunBase = 0;           // 驱动层计数按端口累计，换端口后重新计
+
+    {
+        QMutexLocker locker(&m_txLock);
+        m_txPending.resize(0);
+        m_txOutstanding.store(0, std::memory_order_relaxed);
+        m_open.store(true, std::memory_order_release);
+    }
+    updateBackpressure();
+    return true;
+}
+
+/**
+ * @brief 关闭串口
+ * @return 关闭前是否处于打开状态
+ */
+bool SerialIoWorker::closePort()
+{
+    // 与入队在同一把锁内切换状态并丢弃未写出的数据：
+    // 关闭后不会再有数据入队，也不会残留未扣除的 m_txOutstanding
+    {
+        QMutexLocker locker(&m_txLock);
+        m_open.store(false, std::memory_order_release);
+        m_txPending.resize(0);
+        m_txOutstanding.store(0, std::memory_order_relaxed);
+    }
+    updateBackpressure();
+
+    if (!m_serial->isOpen())
+        return false;
+
+    m_serial->close();
+    return true;
+}
+
+/**
+ * @brief 写入发送队列
+ */
+void SerialIoWorker::enqueueTx(const char *data, int size)
+{
+    if (size <= 0) return;
+
+    {
+        QMutexLocker locker(&m_txLock);
+        if (!isOpen()) return;      // 在锁内判断，避免与 closePort() 交错
+        m_txPending.append(data, size);
+        m_txOutstanding.fetch_add(size, std::memory_order_relaxed);
+    }
+    scheduleFlush();
+}
+
+/**
+ * @brief 分段写入一帧，不生成临时数据包
+ */
+bool SerialIoWorker::enqueueTxFrame(quint16 cmd, const char *payload, int size, QByteArray *sent)
+{
+    uint8_t header[serialModule::kFrameHeaderSize];
+    if (!serialModule::frameHeader(cmd, size, header))
+        return false;
+    quint16 crc = serialModule::frameCrc(header, payload, size);
+    const char tail[2] = { static_cast<char>(crc & 0xFF), static_cast<char>((crc >> 8) & 0xFF) };
+
+    const int total = serialModule::kFrameHeaderSize + size + 2;
+    {
+        QMutexLocker locker(&m_txLock);
+        if (!isOpen()) return false;
+        m_txPending.append(reinterpret_cast<const char *>(header), serialModule::kFrameHeaderSize);
+        if (size > 0)
+            m_txPending.append(payload, size);
+        m_txPending.append(tail, 2);
+        m_txOutstanding.fetch_add(total, std::memory_order_relaxed);
+    }
+    if (sent) {
+        sent->reserve(sent->size() + total);
+        sent->append(reinterpret_cast<const char *>(header), serialModule::kFrameHeaderSize);
+        sent->append(payload, size);
+        sent->append(tail, 2);
+    }
+    scheduleFlush();
+    return true;
+}
+
+/**
+ * @brief 每轮事件循环最多投递一次 flushTx
+ */
+void SerialIoWorker::scheduleFlush()
+{
+    // 始终排队执行，使同一轮内的多次发送合并
+    if (!m_txFlushScheduled.exchange(true, std::memory_order_acq_rel))
+        QMetaObject::invokeMethod(this, "flushTx", Qt::QueuedConnection);
+}
+
+/**
+ * @brief 交换缓冲区后一次性写入串口
+ */
+void SerialIoWorker::flushTx()
+{
+    m_txFlushScheduled.store(false, std::memory_order_release);
+
+    {
+        QMutexLocker locker(&m_txLock);
+        m_txPending.swap(m_txWriting);
+    }
+
+    if (m_txWriting.isEmpty())
+        return;
+
+    if (m_capture.isOpen())
+        m_capture.record(SerialCaptureTx, m_txWriting.constData(), m_txWriting.size());
+
+    // 串口已被关闭（如设备拔出）时整批丢弃，同样从未写出字节数中扣除，避免拥塞状态卡住
+    const qint64 queued = m_serial->isOpen() ? m_serial->write(m_txWriting.constData(), m_txWriting.size()) : 0;
+    if (queued < m_txWriting.size())
+        m_txOutstanding.fetch_sub(m_txWriting.size() - qMax<qint64>(queued, 0), std::memory_order_relaxed);
+    m_txWriting.resize(0);
+
+    updateBackpressure();
+}
+
+/**
+ * @brief 串口真正写出数据后回调，用于统计和拥塞控制
+ */
+void SerialIoWorker::onPortBytesWritten(qint64 bytes)
+{
+    m_stats->addTx(bytes);
+    m_txOutstanding.fetch_sub(bytes, std::memory_order_relaxed);
+    emit bytesWritten(bytes);
+
+    updateBackpressure();
+}
+
+/**
+ * @brief 根据高低水位更新拥塞状态
+ */
+void SerialIoWorker::updateBackpressure()
+{
+    const qint64 outstanding = m_txOutstanding.load(std::memory_order_relaxed);
+
+    if (!m_txCongested && outstanding > kTxHighWatermark) {
+        m_txCongested = true;
+        emit backpressureChanged(true);
+    } else if (m_txCongested && outstanding < kTxLowWatermark) {
+        m_txCongested = false;
+        emit backpressureChanged(false);
+    }
+}
+
+/**
+ * @brief 清空串口收发缓冲区
+ */
+void SerialIoWorker::clear()
+{
+    if (m_serial->isOpen()) {
+        m_serial->clear(QSerialPort::AllDirections);
+    }
+    m_frameParser.reset();
+}
+
+/**
+ * @brief 开始抓包
+ */
+bool SerialIoWorker::startCapture(const QString &path)
+{
+    return m_capture.open(QFile::encodeName(path).constData());
+}
+
+/**
+ * @brief 停止抓包并刷新文件
+ */
+void SerialIoWorker::stopCapture()
+{
+    m_capture.close();
+}
+
+/**
+ * @brief 读取串口驱动的溢出计数（UART FIFO 溢出 + tty 缓冲区溢出）
+ */
+void SerialIoWorker::sampleLineCounters()
+{
+#ifdef Q_OS_LINUX
+    if (!m_serial->isOpen()) return;
+
+    struct serial_icounter_struct icount;
+    if (ioctl(static_cast<int>(m_serial->handle()), TIOCGICOUNT, &icount) == 0) {
+        const quint64 overruns = static_cast<quint64>(icount.overrun) + icount.buf_overrun;
+        m_stats->setUartOverruns(overruns >= m_uartOverrunBase ? overruns - m_uartOverrunBase : overruns);
+    }
+#endif
+}
+
+/**
+ * @brief 清零统计：计数器只由本线程更新，在这里清零不会与更新交错；
+ *        帧解析器的累计计数和驱动层溢出计数同时归零，不会在下一个数据块后恢复
+ */
+void SerialIoWorker::resetStatistics()
+{
+    m_frameParser.resetCounters();
+    m_uartOverrunBase = 0;
+
+#ifdef Q_OS_LINUX
+    struct serial_icounter_struct icount;
+    if (m_serial->isOpen() &&
+        ioctl(static_cast<int>(m_serial->handle()), TIOCGICOUNT, &icount) == 0)
+        m_uartOverrunBase = static_cast<quint64>(icount.overrun) + icount.buf_overrun;
+#endif
+
+    m_stats->resetCounters();
+}
+
+/**
+ * @brief 入队，队列满时丢弃并计数
+ */
+void SerialIoWorker::enqueue(SerialRxItem &&item)
+{
+    if (!m_rxQueue.push(std::move(item)))
+        m_stats->addQueueOverrun();
+}
+
+/**
+ * @brief 通知消费者；消费者取走数据之前重复的通知会被合并
+ */
+void SerialIoWorker::notifyRx()
+{
+    if (!m_rxPending.exchange(true, std::memory_order_acq_rel))
+        emit rxReady();
+}
+
+/**
+ * @brief 串口接收：读入栈上缓冲区，解析帧并放入接收队列
+ */
+void SerialIoWorker::readSerialData()
+{
+    char buf[4096];
+    qint64 n;
+    bool received = false;
+
+    while ((n = m_serial->read(buf, sizeof(buf))) > 0) {
+        received = true;
+        m_stats->addRx(n);
+
+        if (m_capture.isOpen())
+            m_capture.record(SerialCaptureRx, buf, static_cast<uint32_t>(n));
+
+        if (m_rawForwarding.load(std::memory_order_relaxed)) {
+            SerialRxItem raw;
+            raw.type = SerialRxItem::RawData;
+            raw.data = QByteArray(buf, static_cast<int>(n));
+            enqueue(std::move(raw));
+        }
+
+        // 送入帧解析器，缓冲区满时先取走已完成的帧
+        const uint8_t *p = reinterpret_cast<const uint8_t *>(buf);
+        size_t remain = static_cast<size_t>(n);
+        SerialFrameParser::Frame frame;
+        int frames = 0;
+        while (remain > 0) {
+            size_t accepted = m_frameParser.push(p, remain);
+            p += accepted;
+            remain -= accepted;
+
+            while (m_frameParser.next(frame)) {
+                SerialRxItem item;
+                item.type = SerialRxItem::Frame;
+                item.cmd = frame.cmd;
+                item.data = QByteArray(reinterpret_cast<const char *>(frame.payload),
+                                       frame.payloadSize);
+                enqueue(std::move(item));
+                frames++;
+            }
+        }
+
+        // 统计按数据块更新，不逐字节
+        m_stats->addFrames(frames, m_clock.nsecsElapsed() / 1000);
+        m_stats->setParserCounters(m_frameParser.crcErrors(),
+                                   m_frameParser.lengthErrors(),
+                                   m_frameParser.droppedBytes());
+    }
+
+    if (received)
+        notifyRx();
+}
+
+/**
+ * @brief 串口错误处理
+ */
+void SerialIoWorker::handleError(QSerialPort::SerialPortError error)
+{
+    if (error == QSerialPort::NoError) return;
+    m_stats->addPortError();
+    emit errorOccurred(m_serial->errorString());
+}
@@ -0,0 +1,131 @@
+#ifndef SERIALIOWORKER_H
+#define SERIALIOWORKER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QSerialPort>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <atomic>
+
+#include "serialmodule.h"
+#include "serialframeparser.h"
+#include "spscqueue.h"
+#include "serialcapture.h"
+#include "serialstats.h"
+
+/**
+ * @brief 接收队列中的一项：原始数据块或解析出的帧
+ */
+struct SerialRxItem {
+    enum Type { RawData, Frame };
+    Type type = RawData;
+    quint16 cmd = 0;     ///< 帧指令（仅 Frame 有效）
+    QByteArray data;     ///< 原始数据块或帧的扩展数据
+};
+
+/**
+ * @brief 串口 I/O 工作对象
+ *
+ * 持有 QSerialPort 并完成读取与帧解析，可以运行在主线程，
+ * 也可以被 serialModule 移动到独立的 I/O 线程中：
+ * - 接收结果写入无锁 SPSC 队列，通过 rxReady 通知消费者（合并通知）
+ * - 发送数据写入发送队列，同一轮事件循环内的多次发送合并为一次 write()
+ * - 所有公有槽只应在工作对象所在线程中调用（跨线程时使用 invokeMethod）
+ */
+class SerialIoWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef SpscQueue<SerialRxItem, 1024> RxQueue;
+
+    explicit SerialIoWorker(SerialStats *stats, QObject *parent = nullptr);
+    ~SerialIoWorker();
+
+    // ================= 线程安全接口 =================
+    bool isOpen() const { return m_open.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 是否把原始数据块也放入接收队列（无人关心原始数据时关闭以省去拷贝）
+     */
+    void setRawForwarding(bool enabled) { m_rawForwarding.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * @brief 消费者：取出一项接收数据
+     */
+    bool popRx(SerialRxItem &item) { return m_rxQueue.pop(item); }
+
+    /**
+     * @brief 消费者：开始处理队列前调用，允许生产者发出下一次 rxReady
+     */
+    void clearRxPending() { m_rxPending.store(false, std::memory_order_release); }
+
+    /**
+     * @brief 写入发送队列（任意线程）
+     */
+    void enqueueTx(const char *data, int size);
+
+    /**
+     * @brief 把一帧分段写入发送队列：帧头、扩展数据、CRC（任意线程）
+     * @param sent 非空时追加实际写入队列的整帧字节
+     * @return 扩展数据超过 serialModule::kMaxPayloadSize 或串口未打开时返回 false
+     */
+    bool enqueueTxFrame(quint16 cmd, const char *payload, int size, QByteArray *sent = nullptr);
+
+    /**
+     * @brief 已入队但串口尚未真正写出的字节数
+     */
+    qint64 pendingTxBytes() const { return m_txOutstanding.load(std::memory_order_relaxed); }
+
+    static const qint64 kTxHighWatermark = 64 * 1024; ///< 超过此值报告拥塞
+    static const qint64 kTxLowWatermark = 16 * 1024;  ///< 低于此值解除拥塞
+
+public slots:
+    bool openPort(const QString &portName, const serialModule::SerialConfig &config);
+    bool closePort();
+    void clear();
+    bool startCapture(const QString &path);  ///< 开始把收发数据记录到抓包文件
+    void stopCapture();
+    void sampleLineCounters();               ///< 读取驱动层溢出计数到统计对象
+    void resetStatistics();                  ///< 清零统计计数（含帧解析器和驱动层计数基准）
+
+signals:
+    void rxReady();                          ///< 接收队列有新数据（合并通知）
+    void bytesWritten(qint64 bytes);         ///< 已写入串口的字节数
+    void backpressureChanged(bool congested); ///< 发送拥塞状态变化
+    void errorOccurred(const QString &errorMsg);
+
+private slots:
+    void readSerialData();
+    void handleError(QSerialPort::SerialPortError error);
+    void flushTx();                          ///< 把发送队列一次性写入串口
+    void onPortBytesWritten(qint64 bytes);
+
+private:
+    void enqueue(SerialRxItem &&item);
+    void notifyRx();
+    void scheduleFlush();
+    void updateBackpressure();
+
+    QSerialPort *m_serial = nullptr;   ///< 串口对象（随工作对象一起移动线程）
+    SerialFrameParser m_frameParser;   ///< 接收帧解析器
+    SerialCaptureWriter m_capture;     ///< 抓包记录（只在 I/O 线程访问）
+    SerialStats *m_stats;              ///< 收发统计（由 serialModule 持有）
+    QElapsedTimer m_clock;             ///< 帧到达时间戳
+    RxQueue m_rxQueue;                 ///< I/O 线程 -> 消费者
+
+    std::atomic<bool> m_open;
+    std::atomic<bool> m_rawForwarding;
+    std::atomic<bool> m_rxPending;
+
+    QMutex m_txLock;                   ///< 保护 m_txPending，入队时的打开状态判断与 closePort() 互斥
+    QByteArray m_txPending;            ///< 等待写入的发送数据（生产者追加）
+    QByteArray m_txWriting;            ///< 正在写入的数据（与 m_txPending 交换，复用容量）
+    std::atomic<bool> m_txFlushScheduled;
+    std::atomic<qint64> m_txOutstanding; ///< 已入队未写出的字节数
+    bool m_txCongested = false;        ///< 当前是否拥塞（I/O 线程访问）
+    quint64 m_uartOverrunBase = 0;     ///< 清零时的驱动层溢出计数（TIOCGICOUNT 只增不减）
+};
+
+#endif // SERIALIOWORKER_H
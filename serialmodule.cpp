@@ -1,4 +1,10 @@
 #include "serialmodule.h"
+#include "serialioworker.h"
+#include "serialframeparser.h"
+#include "crc16.h"
+
+#include <QMetaMethod>
+#include <QThread>
 
 /**
  * @brief 构造函数
@@ -6,11 +12,16 @@
  */
 serialModule::serialModule(QObject *parent) : QObject(parent)
 {
-    // 创建串口对象
-    m_serial = new QSerialPort(this);
+    // 跨线程调用 openPort 时需要传递配置结构体
+    qRegisterMetaType<serialModule::SerialConfig>("serialModule::SerialConfig");
+
+    // 默认与本对象同一线程
+    createWorker(false);
 
-    // 初始化串口信号与槽
-    setupSerialPort();
+    // 速率按秒计算，计数器由 I/O 工作对象按数据块更新
+    m_statsClock.start();
+    m_statsTimer.setInterval(1000);
+    connect(&m_statsTimer, &QTimer::timeout, this, &serialModule::updateStatistics);
 }
 
 /**
@@ -19,6 +30,7 @@ serialModule::serialModule(QObject *parent) : QObject(parent)
 serialModule::~serialModule()
 {
     closeSerial();  // 析构时关闭串口
+    destroyWorker();
 }
 
 /**
@@ -35,31 +47,67 @@ QStringList serialModule::availablePorts() const
     return portList;
 }
 
-QByteArray serialModule::packCommand(quint16 cmd, const QByteArray &payload)
+/**
+ * @brief 生成帧头 AA AA | 长度 | 指令
+ * @param header 输出缓冲区
+ * @return 帧头长度，扩展数据超长（长度字段放不下）时返回 0
+ */
+int serialModule::frameHeader(quint16 cmd, int payloadSize, uint8_t header[kFrameHeaderSize])
 {
-    QByteArray packet;
+    if (payloadSize < 0 || payloadSize > kMaxPayloadSize)
+        return 0;
 
     // 1. 包头 AA AA
-    packet.append(0xAA);
-    packet.append(0xAA);
+    header[0] = 0xAA;
+    header[1] = 0xAA;
 
     // 2. 长度 = 控制指令2字节 + payload长度
-    quint16 len = 2 + payload.size();
-    packet.append(static_cast<char>((len >> 8) & 0xFF)); // 高字节
-    packet.append(static_cast<char>(len & 0xFF));        // 低字节
+    quint16 len = 2 + payloadSize;
+    header[2] = (len >> 8) & 0xFF; // 高字节
+    header[3] = len & 0xFF;        // 低字节
 
     // 3. 控制指令 2 字节
-    packet.append(static_cast<char>((cmd >> 8) & 0xFF)); // 高字节
-    packet.append(static_cast<char>(cmd & 0xFF));        // 低字节
+    header[4] = (cmd >> 8) & 0xFF; // 高字节
+    header[5] = cmd & 0xFF;        // 低字节
+
+    return kFrameHeaderSize;
+}
+
+/**
+ * @brief 计算帧 CRC
+ *
+ * CRC计算从“长度字段开始”，长度=len字节，依次覆盖帧头中的长度/指令
+ * 字段与扩展数据，分段累计计算，不需要先拼出完整数据包。
+ */
+quint16 serialModule::frameCrc(const uint8_t header[kFrameHeaderSize], const char *payload, int payloadSize)
+{
+    int len = 2 + payloadSize;
+    int fromHeader = qMin(len, kFrameHeaderSize - 2);
+
+    quint16 crc = crc16_modbus(header + 2, fromHeader);
+    if (len > fromHeader)
+        crc = crc16_modbus(reinterpret_cast<const uint8_t *>(payload), len - fromHeader, crc);
+    return crc;
+}
+
+QByteArray serialModule::packCommand(quint16 cmd, const QByteArray &payload)
+{
+    uint8_t header[kFrameHeaderSize];
+    if (!frameHeader(cmd, payload.size(), header))
+        return QByteArray();    // 扩展数据超长，长度字段放不下
+    quint16 crc = frameCrc(header, payload.constData(), payload.size());
+
+    // 一次分配：帧头 + 扩展数据 + CRC
+    QByteArray packet;
+    packet.reserve(kFrameHeaderSize + payload.size() + 2);
+    packet.append(reinterpret_cast<const char *>(header), kFrameHeaderSize);
 
     // 4. 可选扩展数据
     if (!payload.isEmpty()) {
         packet.append(payload);
     }
 
-    // 5. 计算 CRC16
-    // CRC计算从“长度字段开始”，长度=len字节
-    quint16 crc = crc16(reinterpret_cast<const uint8_t*>(packet.constData() + 2), len);
+    // 5. CRC16
     packet.append(static_cast<char>(crc & 0xFF));        // CRC低字节
     packet.append(static_cast<char>((crc >> 8) & 0xFF)); // CRC高字节
 
@@ -67,15 +115,65 @@ QByteArray serialModule::packCommand(quint16 cmd, const QByteArray &payload)
 }
 
 /**
- * @brief 初始化串口信号连接
+ * @brief 创建串口 I/O 工作对象
+ * @param threaded true=移动到独立 I/O 线程
+ */
+void serialModule::createWorker(bool threaded)
+{
+    m_worker = new SerialIoWorker(&m_stats);
+
+    if (threaded) {
+        m_ioThread = new QThread(this);
+        m_ioThread->setObjectName("serial-io");
+        m_worker->moveToThread(m_ioThread);
+        connect(m_ioThread, &QThread::finished, m_worker, &QObject::deleteLater);
+        m_ioThread->start(QThread::HighPriority);
+    }
+
+    // 跨线程时以下连接自动成为排队连接
+    connect(m_worker, &SerialIoWorker::rxReady, this, &serialModule::drainRxQueue);
+    connect(m_worker, &SerialIoWorker::bytesWritten, this, &serialModule::onBytesWritten);
+    connect(m_worker, &SerialIoWorker::backpressureChanged, this, &serialModule::sendBackpressure);
+    connect(m_worker, &SerialIoWorker::errorOccurred, this, &serialModule::errorOccurred);
+
+    updateRawForwarding();
+}
+
+/**
+ * @brief 销毁串口 I/O 工作对象
  */
-void serialModule::setupSerialPort()
+void serialModule::destroyWorker()
 {
-    // 当串口有数据可读时触发 readSerialData
-    connect(m_serial, &QSerialPort::readyRead, this, &serialModule::readSerialData);
+    if (!m_worker) return;
+
+    disconnect(m_worker, nullptr, this, nullptr);
 
-    // 当串口发生错误时触发 handleError
-    connect(m_serial, &QSerialPort::errorOccurred, this, &serialModule::handleError);
+    if (m_ioThread) {
+        // 工作对象在线程结束时由 deleteLater 释放
+        m_ioThread->quit();
+        m_ioThread->wait();
+        delete m_ioThread;
+        m_ioThread = nullptr;
+    } else {
+        delete m_worker;
+    }
+    m_worker = nullptr;
+}
+
+/**
+ * @brief 需要返回值的调用：I/O 线程中阻塞等待，同线程直接调用
+ */
+Qt::ConnectionType serialModule::callType() const
+{
+    return m_ioThread ? Qt::BlockingQueuedConnection : Qt::DirectConnection;
+}
+
+/**
+ * @brief 不需要返回值的调用：I/O 线程中排队执行，同线程直接调用
+ */
+Qt::ConnectionType serialModule::postType() const
+{
+    return m_ioThread ? Qt::QueuedConnection : Qt::DirectConnection;
 }
 
 /* ================= CRC16/Modbus 算法 ================= */
@@ -84,20 +182,12 @@ void serialModule::setupSerialPort()
  * @param data 数据指针
  * @param len  数据长度
  * @return CRC16 结果
+ *
+ * 具体实现（逐位/查表/slice-by-8）见 crc16.h，编译期选择
  */
 uint16_t serialModule::crc16(const uint8_t *data, uint16_t len)
 {
-    uint16_t crc = 0xFFFF;
-    for(uint16_t i = 0; i < len; i++) {
-        crc ^= data[i];
-        for(uint8_t j = 0; j < 8; j++) {
-            if(crc & 0x0001)
-                crc = (crc >> 1) ^ 0xA001;
-            else
-                crc >>= 1;
-        }
-    }
-    return crc;
+    return crc16_modbus(data, len);
 }
 
 /* ================= 校验 CRC ================= */
@@ -109,12 +199,14 @@ uint16_t serialModule::crc16(const uint8_t *data, uint16_t len)
  */
 bool serialModule::checkCrc(const uint8_t *frame, uint16_t frame_len)
 {
-    if(frame_len < 5) return false; // 最小帧长 = Header(2)+Length(2)+Command(1)
+    // 最小帧长 = Header(2)+Length(2)+Command(2)+CRC(2)
+    if(frame_len < SerialFrameParser::kFrameOverhead) return false;
 
     uint16_t length = (frame[2] << 8) | frame[3];  // 获取帧长度
-    if(length + 2 != frame_len - 2) return false;  // 长度不匹配
+    if(length + 6 != frame_len) return false;      // 长度不匹配
 
-    uint16_t crc_calc = crc16(&frame[2], length - 2); // 计算CRC
+    // 与 packCommand 一致：CRC 从长度字段开始计算 length 字节
+    uint16_t crc_calc = crc16(&frame[2], length);
     uint16_t crc_recv = frame[frame_len-2] | (frame[frame_len-1]<<8); // 接收到的CRC
 
     return crc_calc == crc_recv;
@@ -130,34 +222,22 @@ bool serialModule::checkCrc(const uint8_t *frame, uint16_t frame_len)
  */
 bool serialModule::openSerial(const QString &portName, const SerialConfig &config)
 {
-    // 如果串口已打开，先关闭
-    if (m_serial->isOpen()) {
-        m_serial->close();
-    }
-
-    m_serial->setPortName(portName);
-
-    // 尝试打开串口
-    if (!m_serial->open(QIODevice::ReadWrite)) {
+    // 打开串口（如果串口已打开，工作对象会先关闭）
+    bool ok = false;
+    QMetaObject::invokeMethod(m_worker, "openPort", callType(),
+                              Q_RETURN_ARG(bool, ok),
+                              Q_ARG(QString, portName),
+                              Q_ARG(serialModule::SerialConfig, config));
+    if (!ok) {
         emit errorOccurred(QString("打开串口失败: %1").arg(portName));
         return false;
     }
 
-    // 设置串口参数
-    m_serial->setBaudRate(config.baudRate);
-    m_serial->setDataBits(config.dataBits);
-    m_serial->setParity(config.parity);
-    m_serial->setStopBits(config.stopBits);
-    m_serial->setFlowControl(config.flowControl);
-
-    // 控制信号（DTR、RTS）
-    m_serial->setDataTerminalReady(config.dtrEnabled);
-    m_serial->setRequestToSend(config.rtsEnabled);
-
     // 保存当前串口信息
     m_currentPort = portName;
     m_currentConfig = config;
 
+    m_statsTimer.start();
     emit serialOpened();  // 通知UI
     emit statusMessage(QString("串口已打开: %1").arg(portName));
     return true;
@@ -180,8 +260,12 @@ bool serialModule::openSerial(const QString &portName, int baudRate)
  */
 void serialModule::closeSerial()
 {
-    if (m_serial->isOpen()) {
-        m_serial->close();
+    if (!m_worker) return;
+
+    bool wasOpen = false;
+    QMetaObject::invokeMethod(m_worker, "closePort", callType(), Q_RETURN_ARG(bool, wasOpen));
+    m_statsTimer.stop();
+    if (wasOpen) {
         emit serialClosed();
         emit statusMessage(QString("串口已关闭"));
     }
@@ -192,7 +276,7 @@ void serialModule::closeSerial()
  */
 bool serialModule::isOpen() const
 {
-    return m_serial->isOpen();
+    return m_worker->isOpen();
 }
 
 /**
@@ -200,29 +284,45 @@ bool serialModule::isOpen() const
  */
 QString serialModule::portStatus() const
 {
-    return m_serial->isOpen() ? "已打开" : "已关闭";
+    return isOpen() ? "已打开" : "已关闭";
 }
 
 // ================= 数据发送 =================
 
 /**
  * @brief 发送二进制数据
+ *
+ * 数据进入发送队列，同一轮事件循环内的多次发送合并为一次 write()，
+ * 实际写入字节数由 onBytesWritten 统计
  */
 void serialModule::sendData(const QByteArray &data)
 {
-    if (!m_serial->isOpen()) return;
+    if (!isOpen()) return;
 
-    qint64 sent = m_serial->write(data); // 写入数据
-    m_totalBytesSent += sent;            // 更新统计
-    emit bytesSent(sent);
+    m_worker->enqueueTx(data.constData(), data.size());
     emit dataSent(data, m_hexMode);
 }
 
 /**
  * @brief 发送字符串数据
+ *
+ * 纯ASCII的短文本直接按字节写入，不产生 UTF-8 编码的临时数组
  */
 void serialModule::sendData(const QString &text)
 {
+    const int size = text.size();
+    if (size <= 256) {
+        char buf[256];
+        const QChar *chars = text.constData();
+        int i = 0;
+        for (; i < size && chars[i].unicode() < 0x80; ++i)
+            buf[i] = static_cast<char>(chars[i].unicode());
+        if (i == size) {
+            sendData(buf, size);
+            return;
+        }
+    }
+
     sendData(text.toUtf8());
 }
 
@@ -231,7 +331,54 @@ void serialModule::sendData(const QString &text)
  */
 void serialModule::sendData(const char *data, int size)
 {
-    sendData(QByteArray(data, size));
+    if (!isOpen() || size <= 0) return;
+
+    m_worker->enqueueTx(data, size);
+    emitDataSent(data, size);
+}
+
+/**
+ * @brief 发送一帧指令
+ */
+bool serialModule::sendCommand(quint16 cmd, const QByteArray &payload, QByteArray *sent)
+{
+    if (!isOpen()) return false;
+
+    if (payload.size() > kMaxPayloadSize) {
+        emit errorOccurred(QString("指令 0x%1 扩展数据过长: %2 字节（上限 %3）")
+                           .arg(cmd, 4, 16, QChar('0')).arg(payload.size()).arg(kMaxPayloadSize));
+        return false;
+    }
+
+    static const QMetaMethod sentSignal = QMetaMethod::fromSignal(&serialModule::dataSent);
+    const bool notify = isSignalConnected(sentSignal);
+
+    // 只有需要时才复制一份整帧
+    QByteArray frame;
+    if (!m_worker->enqueueTxFrame(cmd, payload.constData(), payload.size(),
+                                  (notify || sent) ? &frame : nullptr))
+        return false;
+
+    if (notify)
+        emit dataSent(frame, m_hexMode);
+    if (sent)
+        *sent = frame;
+    return true;
+}
+
+/**
+ * @brief 发送队列中尚未写入串口的字节数
+ */
+qint64 serialModule::pendingSendBytes() const
+{
+    return m_worker->pendingTxBytes();
+}
+
+void serialModule::emitDataSent(const char *data, int size)
+{
+    static const QMetaMethod sentSignal = QMetaMethod::fromSignal(&serialModule::dataSent);
+    if (isSignalConnected(sentSignal))
+        emit dataSent(QByteArray(data, size), m_hexMode);
 }
 
 /**
@@ -239,8 +386,8 @@ void serialModule::sendData(const char *data, int size)
  */
 void serialModule::clearBuffers()
 {
-    if (m_serial->isOpen()) {
-        m_serial->clear(QSerialPort::AllDirections);
+    if (isOpen()) {
+        QMetaObject::invokeMethod(m_worker, "clear", postType());
     }
 }
 
@@ -256,36 +403,148 @@ serialModule::SerialConfig serialModule::currentConfig() const
     return m_currentConfig;
 }
 
+bool serialModule::setIoThreadEnabled(bool enabled)
+{
+    if (enabled == isIoThreadEnabled()) return true;
+
+    if (isOpen()) {
+        emit errorOccurred(QString("串口打开时无法切换I/O线程模式"));
+        return false;
+    }
+
+    destroyWorker();
+    createWorker(enabled);
+    return true;
+}
+
+bool serialModule::isIoThreadEnabled() const
+{
+    return m_ioThread != nullptr;
+}
+
+bool serialModule::startCapture(const QString &path)
+{
+    bool ok = false;
+    QMetaObject::invokeMethod(m_worker, "startCapture", callType(),
+                              Q_RETURN_ARG(bool, ok), Q_ARG(QString, path));
+    if (!ok) {
+        emit errorOccurred(QString("创建抓包文件失败: %1").arg(path));
+        return false;
+    }
+
+    emit statusMessage(QString("开始抓包: %1").arg(path));
+    return true;
+}
+
+void serialModule::stopCapture()
+{
+    QMetaObject::invokeMethod(m_worker, "stopCapture", callType());
+}
+
+SerialStats::Snapshot serialModule::statistics() const
+{
+    return m_stats.snapshot();
+}
+
+bool serialModule::dumpStatistics(const QString &path) const
+{
+    return m_stats.dumpToFile(path);
+}
+
+void serialModule::resetStatistics()
+{
+    // 计数器在 I/O 线程中清零（等待完成），速率状态属于本线程
+    if (m_worker)
+        QMetaObject::invokeMethod(m_worker, "resetStatistics", callType());
+    else
+        m_stats.resetCounters();
+    m_stats.resetRates();
+    m_reportedBytesRx = 0;
+}
+
+/**
+ * @brief 有接收者连接原始数据信号时才让工作对象转发原始数据块
+ */
+void serialModule::connectNotify(const QMetaMethod &signal)
+{
+    Q_UNUSED(signal);
+    updateRawForwarding();
+}
+
+void serialModule::disconnectNotify(const QMetaMethod &signal)
+{
+    Q_UNUSED(signal);
+    updateRawForwarding();
+}
+
+void serialModule::updateRawForwarding()
+{
+    if (!m_worker) return;
+
+    static const QMetaMethod rawSignal = QMetaMethod::fromSignal(&serialModule::dataReceived);
+    static const QMetaMethod textSignal = QMetaMethod::fromSignal(&serialModule::dataReceivedText);
+    static const QMetaMethod hexSignal = QMetaMethod::fromSignal(&serialModule::dataReceivedHex);
+
+    m_worker->setRawForwarding(isSignalConnected(rawSignal) ||
+                               isSignalConnected(textSignal) ||
+                               isSignalConnected(hexSignal));
+}
+
 // ================= 私有槽函数 =================
 
 /**
- * @brief 串口接收槽函数
+ * @brief 接收队列处理槽函数
+ *
+ * 在本对象所在线程（通常是GUI线程）中执行，I/O 线程连续收到的
+ * 多块数据只会触发一次调用。
  */
-void serialModule::readSerialData()
+void serialModule::drainRxQueue()
 {
-    if (!m_serial->isOpen()) return;
+    if (!m_worker) return;
 
-    QByteArray data = m_serial->readAll();
-    if (data.isEmpty()) return;
+    static const QMetaMethod textSignal = QMetaMethod::fromSignal(&serialModule::dataReceivedText);
 
-    m_totalBytesReceived += data.size();
-    emit bytesReceived(data.size());   // 通知接收字节数
-    emit dataReceived(data);           // 通知原始数据
+    // 先清除通知标志，再取数据，保证之后入队的数据会再次触发通知
+    m_worker->clearRxPending();
 
-    if (m_hexMode) {
-        emit dataReceivedHex(data);    // 16进制格式
-    } else {
-        emit dataReceivedText(QString::fromUtf8(data)); // 文本格式
+    const quint64 total = m_stats.bytesRx();
+    if (total > m_reportedBytesRx) {
+        emit bytesReceived(static_cast<qint64>(total - m_reportedBytesRx)); // 通知接收字节数
+    }
+    m_reportedBytesRx = total;
+
+    SerialRxItem item;
+    while (m_worker->popRx(item)) {
+        if (item.type == SerialRxItem::Frame) {
+            emit frameReceived(item.cmd, item.data);
+            continue;
+        }
+
+        emit dataReceived(item.data);           // 通知原始数据
+
+        if (m_hexMode) {
+            emit dataReceivedHex(item.data);    // 16进制格式
+        } else if (isSignalConnected(textSignal)) {
+            emit dataReceivedText(QString::fromUtf8(item.data)); // 文本格式
+        }
     }
 }
 
 /**
- * @brief 串口错误处理
+ * @brief 串口实际写入字节数
  */
-void serialModule::handleError(QSerialPort::SerialPortError error)
+void serialModule::onBytesWritten(qint64 bytes)
 {
-    if (error == QSerialPort::NoError) return;
-    emit errorOccurred(m_serial->errorString());
+    emit bytesSent(bytes);               // 计数由工作对象写入 m_stats
 }
 
+/**
+ * @brief 统计定时器：更新 EWMA 速率，并让工作对象采样驱动层溢出计数
+ */
+void serialModule::updateStatistics()
+{
+    m_stats.updateRates(m_statsClock.nsecsElapsed() / 1000);
 
+    if (m_worker)
+        QMetaObject::invokeMethod(m_worker, "sampleLineCounters", postType());
+}
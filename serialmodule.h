@@ -5,6 +5,14 @@
 #include <cstdint>
 #include <QSerialPort>
 #include <QSerialPortInfo>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include "serialstats.h"
+#include "serialframeparser.h"
+
+class QThread;
+class SerialIoWorker;
 
 /**
  * @brief 串口管理类 - 针对固定串口的简化版本
@@ -13,7 +21,10 @@
  * - 固定串口设备，不需要动态扫描
  * - 根据用户选择的波特率、停止位等参数打开串口
  * - 支持HEX/文本模式接收
- * - 发送/接收数据统计
+ * - 接收数据按 packCommand() 帧格式流式解析，校验通过后发出 frameReceived
+ * - 可选独立 I/O 线程：串口读取与帧解析不受界面绘制阻塞，
+ *   结果经无锁队列交给本对象所在线程，信号接口保持不变
+ * - 发送/接收数据统计：字节/帧计数、错误与溢出计数、EWMA 速率、帧间隔直方图
  * - 错误与状态信号反馈
  */
 
@@ -36,10 +47,21 @@ public:
     };
 
     // CRC16/Modbus 计算
-    uint16_t crc16(const uint8_t *data, uint16_t len);
+    static uint16_t crc16(const uint8_t *data, uint16_t len);
+
+    // 校验 CRC 是否正确（帧格式与 packCommand 一致）
+    static bool checkCrc(const uint8_t *frame, uint16_t frame_len);
 
-    // 校验 CRC 是否正确
-    bool checkCrc(const uint8_t *frame, uint16_t frame_len);
+    static const int kFrameHeaderSize = 6;  ///< 帧头(2)+长度(2)+指令(2)
+    /// 扩展数据上限：与接收端 SerialFrameParser 的最大帧长一致，对端按同一协议解析
+    static const int kMaxPayloadSize = static_cast<int>(SerialFrameParser::kMaxFrameSize -
+                                                        SerialFrameParser::kFrameOverhead);
+
+    // 生成帧头，返回帧头长度；扩展数据超过 kMaxPayloadSize 时返回 0
+    static int frameHeader(quint16 cmd, int payloadSize, uint8_t header[kFrameHeaderSize]);
+
+    // 计算帧 CRC，帧头与扩展数据分开传入，无需拼接
+    static quint16 frameCrc(const uint8_t header[kFrameHeaderSize], const char *payload, int payloadSize);
 
     explicit serialModule(QObject *parent = nullptr);
     ~serialModule();
@@ -96,6 +118,20 @@ public:
      */
     void sendData(const char *data, int size);
 
+    /**
+     * @brief 直接把一帧写入发送队列（帧头/扩展数据/CRC 分段写入，不拼接临时包）
+     * @param cmd 控制指令
+     * @param payload 扩展数据（不超过 kMaxPayloadSize）
+     * @param sent 非空时返回实际写入队列的整帧字节
+     * @return 是否已写入发送队列
+     */
+    bool sendCommand(quint16 cmd, const QByteArray &payload = QByteArray(), QByteArray *sent = nullptr);
+
+    /**
+     * @brief 已进入发送队列但尚未写入串口的字节数
+     */
+    qint64 pendingSendBytes() const;
+
     /**
      * @brief 清空串口收发缓冲区
      */
@@ -114,6 +150,49 @@ public:
      */
     SerialConfig currentConfig() const;
 
+    /**
+     * @brief 设置是否在独立线程中运行串口 I/O
+     * @param enabled true=独立 I/O 线程，false=与本对象同一线程
+     * @return 串口打开时不能切换，返回false
+     */
+    bool setIoThreadEnabled(bool enabled);
+
+    /**
+     * @brief 是否运行在独立 I/O 线程
+     */
+    bool isIoThreadEnabled() const;
+
+    /**
+     * @brief 开始抓包：收发数据带时间戳写入二进制文件（格式见 serialcapture.h）
+     * @param path 抓包文件路径
+     * @return 文件创建成功返回true
+     */
+    bool startCapture(const QString &path);
+
+    /**
+     * @brief 停止抓包
+     */
+    void stopCapture();
+
+    // ================= 统计接口 =================
+
+    /**
+     * @brief 获取收发统计快照（速率每秒更新一次）
+     */
+    SerialStats::Snapshot statistics() const;
+
+    /**
+     * @brief 把统计信息导出为 key=value 文本文件
+     * @param path 文件路径
+     * @return 写入成功返回true
+     */
+    bool dumpStatistics(const QString &path) const;
+
+    /**
+     * @brief 清零统计计数
+     */
+    void resetStatistics();
+
 	// 添加到 public 接口
 	/**
 	 * @brief 获取系统可用串口列表
@@ -127,6 +206,13 @@ signals:
     void dataReceivedText(const QString &text);
     void dataReceivedHex(const QByteArray &data);
 
+    /**
+     * @brief 解析到一帧校验通过的数据
+     * @param cmd 控制指令
+     * @param payload 扩展数据（不含帧头、长度、指令与CRC）
+     */
+    void frameReceived(quint16 cmd, const QByteArray &payload);
+
     // ================= 状态与错误 =================
     void errorOccurred(const QString &errorMsg);
     void statusMessage(const QString &message);
@@ -136,30 +222,54 @@ signals:
     void serialClosed();
 
     // ================= 统计信号 =================
-    void bytesSent(qint64 bytes);
+    void bytesSent(qint64 bytes);       ///< 实际写入串口的字节数
     void bytesReceived(qint64 bytes);
     void dataSent(const QByteArray &data, bool isHex);
 
+    /**
+     * @brief 发送队列拥塞状态变化（超过高水位为true，回落到低水位以下为false）
+     */
+    void sendBackpressure(bool congested);
+
+protected:
+    void connectNotify(const QMetaMethod &signal) override;
+    void disconnectNotify(const QMetaMethod &signal) override;
+
 private slots:
     /**
-     * @brief 读取串口数据
+     * @brief 取出 I/O 工作对象接收队列中的数据并发出信号
      */
-    void readSerialData();
+    void drainRxQueue();
 
     /**
-     * @brief 串口错误处理
+     * @brief 串口实际写入字节数回调
      */
-    void handleError(QSerialPort::SerialPortError error);
+    void onBytesWritten(qint64 bytes);
+
+    /**
+     * @brief 每秒更新速率并采样驱动层溢出计数
+     */
+    void updateStatistics();
 
 private:
-    void setupSerialPort(); ///< 初始化串口对象
+    void createWorker(bool threaded);   ///< 创建 I/O 工作对象（可选移动到 I/O 线程）
+    void destroyWorker();               ///< 停止 I/O 线程并销毁工作对象
+    void updateRawForwarding();         ///< 根据原始数据信号的连接情况决定是否转发原始数据
+    void emitDataSent(const char *data, int size); ///< 有接收者时才构造 dataSent 参数
+    Qt::ConnectionType callType() const; ///< 需要返回值的调用方式
+    Qt::ConnectionType postType() const; ///< 不需要返回值的调用方式
 
-    QSerialPort *m_serial = nullptr;   ///< 串口对象
+    SerialIoWorker *m_worker = nullptr; ///< 串口 I/O 工作对象
+    QThread *m_ioThread = nullptr;     ///< I/O 线程，未启用时为空
     SerialConfig m_currentConfig;      ///< 当前串口配置
     QString m_currentPort;             ///< 当前串口路径
-    qint64 m_totalBytesSent = 0;       ///< 总发送字节数
-    qint64 m_totalBytesReceived = 0;   ///< 总接收字节数
+    SerialStats m_stats;               ///< 收发统计（I/O 工作对象更新，本对象查询）
+    QTimer m_statsTimer;               ///< 速率更新定时器
+    QElapsedTimer m_statsClock;        ///< 速率计算时间基准
+    quint64 m_reportedBytesRx = 0;     ///< 已通过 bytesReceived 报告的接收字节数
     bool m_hexMode = false;            ///< HEX模式标志
 };
 
+Q_DECLARE_METATYPE(serialModule::SerialConfig)
+
 #endif
@@ -0,0 +1,149 @@
+#include "serialstats.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <QDateTime>
+
+const int SerialStats::kLatencyBuckets;
+
+SerialStats::SerialStats()
+{
+    reset();
+}
+
+void SerialStats::reset()
+{
+    resetCounters();
+    resetRates();
+}
+
+void SerialStats::resetCounters()
+{
+    m_bytesTx.store(0);
+    m_bytesRx.store(0);
+    m_framesRx.store(0);
+    m_crcErrors.store(0);
+    m_lengthErrors.store(0);
+    m_droppedBytes.store(0);
+    m_queueOverruns.store(0);
+    m_uartOverruns.store(0);
+    m_portErrors.store(0);
+    for (int i = 0; i < kLatencyBuckets; ++i)
+        m_frameGap[i].store(0);
+    m_lastFrameUs = -1;
+}
+
+void SerialStats::resetRates()
+{
+    m_rateLastUs = -1;
+    m_rateLastTx = 0;
+    m_rateLastRx = 0;
+    m_rateLastFrames = 0;
+    m_txRate = 0;
+    m_rxRate = 0;
+    m_frameRate = 0;
+}
+
+/**
+ * @brief 记录帧到达；同一数据块内的后续帧间隔为 0
+ */
+void SerialStats::addFrames(int count, qint64 nowUs)
+{
+    if (count <= 0) return;
+
+    m_framesRx.fetch_add(static_cast<quint64>(count), std::memory_order_relaxed);
+
+    int first = 0;
+    if (m_lastFrameUs >= 0) {
+        const qint64 gap = nowUs - m_lastFrameUs;
+        int bucket = 0;
+        while (bucket < kLatencyBuckets - 1 && gap >= bucketUpperUs(bucket))
+            bucket++;
+        m_frameGap[bucket].fetch_add(1, std::memory_order_relaxed);
+        first = 1;
+    }
+    if (count > first)
+        m_frameGap[0].fetch_add(static_cast<quint64>(count - first), std::memory_order_relaxed);
+
+    m_lastFrameUs = nowUs;
+}
+
+void SerialStats::setParserCounters(quint64 crcErrors, quint64 lengthErrors, quint64 droppedBytes)
+{
+    m_crcErrors.store(crcErrors, std::memory_order_relaxed);
+    m_lengthErrors.store(lengthErrors, std::memory_order_relaxed);
+    m_droppedBytes.store(droppedBytes, std::memory_order_relaxed);
+}
+
+/**
+ * @brief EWMA：rate = rate + α * (本周期速率 - rate)，α = 0.3
+ */
+void SerialStats::updateRates(qint64 nowUs)
+{
+    const quint64 tx = bytesTx();
+    const quint64 rx = bytesRx();
+    const quint64 frames = m_framesRx.load(std::memory_order_relaxed);
+
+    if (m_rateLastUs >= 0 && nowUs > m_rateLastUs) {
+        const double seconds = (nowUs - m_rateLastUs) / 1e6;
+        const double alpha = 0.3;
+
+        m_txRate += alpha * ((tx - m_rateLastTx) / seconds - m_txRate);
+        m_rxRate += alpha * ((rx - m_rateLastRx) / seconds - m_rxRate);
+        m_frameRate += alpha * ((frames - m_rateLastFrames) / seconds - m_frameRate);
+    }
+
+    m_rateLastUs = nowUs;
+    m_rateLastTx = tx;
+    m_rateLastRx = rx;
+    m_rateLastFrames = frames;
+}
+
+SerialStats::Snapshot SerialStats::snapshot() const
+{
+    Snapshot s;
+    s.bytesTx = bytesTx();
+    s.bytesRx = bytesRx();
+    s.framesRx = m_framesRx.load(std::memory_order_relaxed);
+    s.crcErrors = m_crcErrors.load(std::memory_order_relaxed);
+    s.lengthErrors = m_lengthErrors.load(std::memory_order_relaxed);
+    s.droppedBytes = m_droppedBytes.load(std::memory_order_relaxed);
+    s.queueOverruns = m_queueOverruns.load(std::memory_order_relaxed);
+    s.uartOverruns = m_uartOverruns.load(std::memory_order_relaxed);
+    s.portErrors = m_portErrors.load(std::memory_order_relaxed);
+    s.txBytesPerSec = m_txRate;
+    s.rxBytesPerSec = m_rxRate;
+    s.framesPerSec = m_frameRate;
+    for (int i = 0; i < kLatencyBuckets; ++i)
+        s.frameGapBuckets[i] = m_frameGap[i].load(std::memory_order_relaxed);
+    return s;
+}
+
+bool SerialStats::dumpToFile(const QString &path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    const Snapshot s = snapshot();
+    QTextStream out(&file);
+    out << "time=" << QDateTime::currentDateTime().toString(Qt::ISODate) << "\n";
+    out << "bytes_tx=" << s.bytesTx << "\n";
+    out << "bytes_rx=" << s.bytesRx << "\n";
+    out << "frames_rx=" << s.framesRx << "\n";
+    out << "crc_errors=" << s.crcErrors << "\n";
+    out << "length_errors=" << s.lengthErrors << "\n";
+    out << "dropped_bytes=" << s.droppedBytes << "\n";
+    out << "queue_overruns=" << s.queueOverruns << "\n";
+    out << "uart_overruns=" << s.uartOverruns << "\n";
+    out << "port_errors=" << s.portErrors << "\n";
+    out << "tx_bytes_per_sec=" << s.txBytesPerSec << "\n";
+    out << "rx_bytes_per_sec=" << s.rxBytesPerSec << "\n";
+    out << "frames_per_sec=" << s.framesPerSec << "\n";
+    for (int i = 0; i < kLatencyBuckets - 1; ++i)
+        out << "frame_gap_lt_" << bucketUpperUs(i) << "us=" << s.frameGapBuckets[i] << "\n";
+    out << "frame_gap_ge_" << bucketUpperUs(kLatencyBuckets - 2) << "us="
+        << s.frameGapBuckets[kLatencyBuckets - 1] << "\n";
+    return true;
+}
@@ -0,0 +1,121 @@
+#ifndef SERIALSTATS_H
+#define SERIALSTATS_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * @brief 串口收发统计
+ *
+ * - 计数器为原子变量，由 I/O 线程按数据块/帧更新（不是逐字节），任意线程可读
+ * - 速率为指数加权移动平均（EWMA），由 updateRates() 周期性计算，
+ *   updateRates()/snapshot() 应在同一个线程中调用（通常是GUI线程）
+ * - 帧间隔直方图采用固定对数分桶，第 i 个桶上界为 128<<i 微秒
+ */
+class SerialStats
+{
+public:
+    static const int kLatencyBuckets = 16;
+
+    struct Snapshot {
+        quint64 bytesTx = 0;          ///< 实际写出的字节数
+        quint64 bytesRx = 0;          ///< 接收字节数
+        quint64 framesRx = 0;         ///< 校验通过的帧数
+        quint64 crcErrors = 0;        ///< CRC 错误帧数
+        quint64 lengthErrors = 0;     ///< 长度非法次数
+        quint64 droppedBytes = 0;     ///< 重新同步丢弃的字节数
+        quint64 queueOverruns = 0;    ///< 接收队列满丢弃的项数
+        quint64 uartOverruns = 0;     ///< 串口驱动报告的硬件/缓冲区溢出次数
+        quint64 portErrors = 0;       ///< QSerialPort 报告的错误次数
+
+        double txBytesPerSec = 0;     ///< 发送速率（EWMA）
+        double rxBytesPerSec = 0;     ///< 接收速率（EWMA）
+        double framesPerSec = 0;      ///< 帧速率（EWMA）
+
+        quint64 frameGapBuckets[kLatencyBuckets] = {}; ///< 帧间隔直方图
+    };
+
+    SerialStats();
+
+    // ================= I/O 线程更新 =================
+    void addTx(qint64 bytes) { m_bytesTx.fetch_add(static_cast<quint64>(bytes), std::memory_order_relaxed); }
+    void addRx(qint64 bytes) { m_bytesRx.fetch_add(static_cast<quint64>(bytes), std::memory_order_relaxed); }
+    void addQueueOverrun() { m_queueOverruns.fetch_add(1, std::memory_order_relaxed); }
+    void addPortError() { m_portErrors.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief 记录一批同时到达的帧
+     * @param count 帧数
+     * @param nowUs 到达时间（单调时钟，微秒）
+     */
+    void addFrames(int count, qint64 nowUs);
+
+    /**
+     * @brief 同步帧解析器的累计错误计数
+     */
+    void setParserCounters(quint64 crcErrors, quint64 lengthErrors, quint64 droppedBytes);
+
+    /**
+     * @brief 同步驱动层溢出计数（TIOCGICOUNT）
+     */
+    void setUartOverruns(quint64 overruns) { m_uartOverruns.store(overruns, std::memory_order_relaxed); }
+
+    quint64 bytesTx() const { return m_bytesTx.load(std::memory_order_relaxed); }
+    quint64 bytesRx() const { return m_bytesRx.load(std::memory_order_relaxed); }
+
+    // ================= 查询 =================
+    /**
+     * @brief 根据计数器增量更新 EWMA 速率
+     * @param nowUs 当前时间（单调时钟，微秒）
+     */
+    void updateRates(qint64 nowUs);
+
+    Snapshot snapshot() const;
+
+    /**
+     * @brief 清零所有计数和速率（只在没有 I/O 线程并发更新时调用，如构造时）
+     */
+    void reset();
+
+    /**
+     * @brief 清零计数器和帧间隔状态（只在 I/O 线程中调用）
+     */
+    void resetCounters();
+
+    /**
+     * @brief 清零 EWMA 速率（只在 updateRates 调用线程中调用）
+     */
+    void resetRates();
+
+    /**
+     * @brief 以 key=value 文本格式写入文件，便于现场导出
+     */
+    bool dumpToFile(const QString &path) const;
+
+    static quint32 bucketUpperUs(int bucket) { return 128u << bucket; }
+
+private:
+    std::atomic<quint64> m_bytesTx;
+    std::atomic<quint64> m_bytesRx;
+    std::atomic<quint64> m_framesRx;
+    std::atomic<quint64> m_crcErrors;
+    std::atomic<quint64> m_lengthErrors;
+    std::atomic<quint64> m_droppedBytes;
+    std::atomic<quint64> m_queueOverruns;
+    std::atomic<quint64> m_uartOverruns;
+    std::atomic<quint64> m_portErrors;
+    std::atomic<quint64> m_frameGap[kLatencyBuckets];
+    qint64 m_lastFrameUs;             ///< 上一帧到达时间（仅 I/O 线程访问）
+
+    // EWMA 状态（仅 updateRates 调用线程访问）
+    qint64 m_rateLastUs;
+    quint64 m_rateLastTx;
+    quint64 m_rateLastRx;
+    quint64 m_rateLastFrames;
+    double m_txRate;
+    double m_rxRate;
+    double m_frameRate;
+};
+
+#endif // SERIALSTATS_H
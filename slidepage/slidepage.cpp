@@ -7,15 +7,27 @@ Copyright © Deng Zhimao Co., Ltd. 1990-2021. All rights reserved.
 *******************************************************************/
 #include "slidepage.h"
 #include <QPropertyAnimation>
+#include <QVariantAnimation>
 #include <QScrollBar>
 #include <QCursor>
 #include <QDebug>
+#include <QMouseEvent>
+#include <QPainter>
 
 SlidePage::SlidePage(QWidget *parent)
     : QWidget(parent),
       pageIndex(0),
       pageCount(0),
-      draggingFlag(false)
+      draggingFlag(false),
+      provider(nullptr),
+      preloadDistance(1),
+      visibleCenter(-1),
+      renderMode(WidgetMode),
+      pixmapOffset(0),
+      pressedFlag(false),
+      pressX(0),
+      pressOffset(0),
+      pageBackground(Qt::lightGray)
 {
     /* 基础设置 */
     this->setMinimumSize(400, 300);                // 默认最小大小
@@ -40,6 +52,12 @@ SlidePage::SlidePage(QWidget *parent)
     bottomHBoxLayout->setContentsMargins(0, 0, 0, 0);
     bottomHBoxLayout->setAlignment(Qt::AlignCenter);
 
+    indicatorText = new QLabel(bottomWidget);
+    indicatorText->setAlignment(Qt::AlignCenter);
+    indicatorText->setStyleSheet("background: transparent; color: white;");
+    indicatorText->hide();
+    bottomHBoxLayout->addWidget(indicatorText);
+
     /* =================== 3. 页面布局 =================== */
     hBoxLayout = new QHBoxLayout();
     hBoxLayout->setContentsMargins(0, 0, 0, 0);
@@ -71,20 +89,45 @@ SlidePage::SlidePage(QWidget *parent)
 
     connect(this, &SlidePage::currentPageIndexChanged,
             this, &SlidePage::onCurrentPageIndexChanged);
+
+    /* =================== 7. 缓存图片模式的偏移动画 =================== */
+    offsetAnimation = new QVariantAnimation(this);
+    offsetAnimation->setDuration(200);
+    offsetAnimation->setEasingCurve(QEasingCurve::OutCurve);
+    connect(offsetAnimation, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
+        setPixmapOffset(value.toInt());
+    });
 }
 
-SlidePage::~SlidePage() {}
+SlidePage::~SlidePage()
+{
+    // 解绑页面后不再访问提供者（子控件析构时的隐藏事件也不会再调用它）
+    setProvider(nullptr);
+}
 
 /**
  * @brief 添加一个新页面
  */
 void SlidePage::addPage(QWidget *w)
 {
+    if (provider) {
+        qDebug() << "SlidePage: addPage ignored, a page provider is set";
+        return;
+    }
+
     // 1. 添加页面到主布局
     hBoxLayout->addWidget(w);
     pageCount++;
 
     // 2. 创建底部指示器
+    addIndicator();
+}
+
+/**
+ * @brief 添加一个底部指示器圆点
+ */
+void SlidePage::addIndicator()
+{
     QLabel *label = new QLabel();
 
     // 【关键修复 ①】固定大小为16x16，防止拉伸
@@ -109,6 +152,323 @@ void SlidePage::addPage(QWidget *w)
     bottomHBoxLayout->addWidget(label);
 }
 
+/**
+ * @brief 按页数重建底部指示器：页数较少时显示圆点，否则显示 "当前/总数"
+ */
+void SlidePage::rebuildIndicator()
+{
+    static const int maxIndicatorDots = 16;
+
+    qDeleteAll(pageIndicator);
+    pageIndicator.clear();
+
+    if (pageCount <= maxIndicatorDots) {
+        indicatorText->hide();
+        for (int i = 0; i < pageCount; ++i)
+            addIndicator();
+    } else {
+        indicatorText->show();
+    }
+
+    if (pageCount > 0)
+        onCurrentPageIndexChanged(pageIndex);
+}
+
+/**
+ * @brief 设置页面提供者，创建固定数量的页面控件
+ */
+void SlidePage::setProvider(SlidePageProvider *p)
+{
+    for (int i = 0; i < pagePool.count(); ++i) {
+        if (provider && pagePoolIndex[i] >= 0)
+            provider->unbindPage(pagePool[i], pagePoolIndex[i]);
+        delete pagePool[i];
+    }
+    pagePool.clear();
+    pagePoolIndex.clear();
+
+    provider = p;
+    if (!provider)
+        return;
+
+    // 控件不加入 hBoxLayout，由 updateVisiblePages 直接摆放到所绑定页的位置
+    const int poolSize = preloadDistance * 2 + 1;
+    for (int i = 0; i < poolSize; ++i) {
+        QWidget *page = provider->createPage();
+        page->setParent(mainWidget);
+        page->hide();
+        pagePool.append(page);
+        pagePoolIndex.append(-1);
+    }
+
+    pageIndex = 0;
+    reloadPages();
+}
+
+/**
+ * @brief 提供者内容变化后重新加载
+ */
+void SlidePage::reloadPages()
+{
+    if (!provider)
+        return;
+
+    const int oldIndex = pageIndex;
+    pageCount = provider->pageCount();
+    pageIndex = qBound(0, pageIndex, qMax(0, pageCount - 1));
+
+    // 所有控件解绑，下次 updateVisiblePages 时重新绑定
+    for (int i = 0; i < pagePool.count(); ++i) {
+        if (pagePoolIndex[i] >= 0) {
+            provider->unbindPage(pagePool[i], pagePoolIndex[i]);
+            pagePoolIndex[i] = -1;
+        }
+        pagePool[i]->hide();
+    }
+
+    pagesChanged(oldIndex);
+}
+
+/**
+ * @brief 插入页面：已绑定控件及当前页索引整体后移
+ */
+void SlidePage::insertPages(int index, int count)
+{
+    if (!provider || count <= 0)
+        return;
+
+    const int oldIndex = pageIndex;
+    pageCount = provider->pageCount();
+
+    for (int i = 0; i < pagePool.count(); ++i) {
+        if (pagePoolIndex[i] >= index) {
+            pagePoolIndex[i] += count;
+            pagePool[i]->setGeometry(pageGeometry(pagePoolIndex[i]));
+        }
+    }
+    if (pageCount > count && pageIndex >= index)
+        pageIndex += count;
+
+    pagesChanged(oldIndex);
+}
+
+/**
+ * @brief 移除页面：被移除的控件解绑，其后的控件及当前页索引整体前移
+ */
+void SlidePage::removePages(int index, int count)
+{
+    if (!provider || count <= 0)
+        return;
+
+    const int oldIndex = pageIndex;
+    pageCount = provider->pageCount();
+
+    for (int i = 0; i < pagePool.count(); ++i) {
+        const int bound = pagePoolIndex[i];
+        if (bound < index)
+            continue;
+        if (bound < index + count) {
+            provider->unbindPage(pagePool[i], bound);
+            pagePool[i]->hide();
+            pagePoolIndex[i] = -1;
+        } else {
+            pagePoolIndex[i] = bound - count;
+            pagePool[i]->setGeometry(pageGeometry(pagePoolIndex[i]));
+        }
+    }
+    if (pageIndex >= index + count)
+        pageIndex -= count;
+    else if (pageIndex >= index)
+        pageIndex = index;
+    pageIndex = qBound(0, pageIndex, qMax(0, pageCount - 1));
+
+    pagesChanged(oldIndex);
+}
+
+/**
+ * @brief 页数变化后调整容器尺寸、滚动位置和指示器，并绑定新进入窗口的页
+ */
+void SlidePage::pagesChanged(int oldIndex)
+{
+    mainWidget->resize(this->width() * pageCount, this->height() - 20);
+    scrollToCurrentPage();
+    rebuildIndicator();
+    updateVisiblePages(true);
+
+    if (oldIndex != pageIndex)
+        emit currentPageIndexChanged(pageIndex);
+}
+
+void SlidePage::setPreloadDistance(int distance)
+{
+    preloadDistance = qMax(0, distance);
+}
+
+QRect SlidePage::pageGeometry(int index) const
+{
+    return QRect(index * this->width(), 0, this->width(), this->height() - 20);
+}
+
+/**
+ * @brief 页面显示区域（底部指示器以上）
+ */
+QRect SlidePage::pageArea() const
+{
+    return QRect(0, 0, this->width(), qMax(0, this->height() - 20));
+}
+
+/**
+ * @brief 把滚动位置/偏移对齐到当前页（不带动画）
+ */
+void SlidePage::scrollToCurrentPage()
+{
+    scrollArea->horizontalScrollBar()->setValue(pageIndex * this->width());
+
+    if (renderMode == PixmapMode) {
+        offsetAnimation->stop();
+        pixmapOffset = pageIndex * this->width();
+        update();
+    }
+}
+
+/**
+ * @brief 切换绘制模式
+ */
+void SlidePage::setRenderMode(RenderMode mode)
+{
+    if (mode == renderMode)
+        return;
+
+    const bool pixmapMode = mode == PixmapMode;
+    if (pixmapMode && provider) {
+        // 释放页面控件的内容，此后只使用提供者的图片
+        for (int i = 0; i < pagePool.count(); ++i) {
+            if (pagePoolIndex[i] >= 0) {
+                provider->unbindPage(pagePool[i], pagePoolIndex[i]);
+                pagePoolIndex[i] = -1;
+            }
+            pagePool[i]->hide();
+        }
+    }
+    renderMode = mode;
+
+    // 不透明控件：Qt 不再先绘制父控件背景，scroll() 可以直接平移已绘制的内容
+    scrollArea->setVisible(!pixmapMode);
+    if (pixmapMode)
+        QScroller::ungrabGesture(scrollArea);
+    else
+        QScroller::grabGesture(scrollArea, QScroller::LeftMouseButtonGesture);
+    setAttribute(Qt::WA_TranslucentBackground, !pixmapMode);
+    setAttribute(Qt::WA_OpaquePaintEvent, pixmapMode);
+
+    visibleCenter = -1;
+    scrollToCurrentPage();
+    updateVisiblePages(true);
+    update();
+}
+
+/**
+ * @brief 内容更新：缓存图片模式下重绘该页的可见部分，控件模式下重新绑定该页
+ */
+void SlidePage::updatePage(int index)
+{
+    if (!provider || index < 0 || index >= pageCount)
+        return;
+
+    if (renderMode == PixmapMode) {
+        const QRect rect = pageGeometry(index).translated(-pixmapOffset, 0) & pageArea();
+        if (!rect.isEmpty())
+            update(rect);
+        return;
+    }
+
+    const int slot = pagePoolIndex.indexOf(index);
+    if (slot >= 0) {
+        provider->unbindPage(pagePool[slot], index);
+        provider->bindPage(pagePool[slot], index);
+    }
+}
+
+/**
+ * @brief 设置缓存图片模式的偏移
+ *
+ * 偏移变化小于一页时用 scroll() 平移已绘制的内容，只重绘新露出的部分。
+ */
+void SlidePage::setPixmapOffset(int offset)
+{
+    offset = qBound(0, offset, qMax(0, (pageCount - 1) * this->width()));
+    const int dx = pixmapOffset - offset;
+    if (dx == 0)
+        return;
+    pixmapOffset = offset;
+
+    const QRect area = pageArea();
+    if (qAbs(dx) < area.width())
+        scroll(dx, 0, area);
+    else
+        update(area);
+
+    updateVisiblePages();
+}
+
+/**
+ * @brief 按滚动位置绑定中心页及两侧 preloadDistance 页，回收窗口外的控件
+ *
+ * 滑动过程中可见的最多是中心页与相邻一页，都在窗口内，不会出现空白页。
+ */
+void SlidePage::updateVisiblePages(bool force)
+{
+    if (!provider || this->width() <= 0 || !isVisible())
+        return;
+
+    const int width = this->width();
+    const int position = renderMode == PixmapMode ? pixmapOffset
+                                                  : scrollArea->horizontalScrollBar()->value();
+    const int center = pageCount > 0 ? qBound(0, (position + width / 2) / width, pageCount - 1) : -1;
+    if (!force && center == visibleCenter)
+        return;
+    visibleCenter = center;
+
+    const int first = qMax(0, center - preloadDistance);
+    const int last = qMin(pageCount - 1, center + preloadDistance);
+
+    // 缓存图片模式不使用页面控件，只让提供者准备窗口内的图片
+    if (renderMode == PixmapMode) {
+        if (center >= 0)
+            provider->preparePixmaps(center, first, last, pageArea().size());
+        return;
+    }
+
+    // 1. 回收窗口外的控件
+    for (int i = 0; i < pagePool.count(); ++i) {
+        const int index = pagePoolIndex[i];
+        if (index >= 0 && (index < first || index > last)) {
+            provider->unbindPage(pagePool[i], index);
+            pagePool[i]->hide();
+            pagePoolIndex[i] = -1;
+        }
+    }
+
+    // 2. 把空闲控件绑定到窗口内尚未绑定的页，从中心页向两侧依次绑定
+    for (int step = 0; step <= 2 * preloadDistance && center >= 0; ++step) {
+        const int index = step % 2 ? center - (step + 1) / 2 : center + step / 2;
+        if (index < first || index > last)
+            continue;
+
+        int slot = pagePoolIndex.indexOf(index);
+        if (slot < 0) {
+            slot = pagePoolIndex.indexOf(-1);
+            if (slot < 0)
+                break;
+            // 先摆放再绑定，提供者可按控件尺寸准备内容
+            pagePoolIndex[slot] = index;
+            pagePool[slot]->setGeometry(pageGeometry(index));
+            provider->bindPage(pagePool[slot], index);
+        }
+        pagePool[slot]->show();
+    }
+}
+
 
 /**
  * @brief 窗口大小变化时自动调整内部布局
@@ -120,19 +480,156 @@ void SlidePage::resizeEvent(QResizeEvent *event)
     scrollArea->resize(this->size());
     mainWidget->resize(this->width() * pageCount, this->height() - 20);
 
-    // 更新初始指示器
+    // 按需加载时页面内容与页面尺寸相关（如按尺寸缩放的图片），尺寸变化后重新绑定
+    if (provider)
+        reloadPages();
+
+    // 更新指示器
     if (pageCount > 0)
-        onCurrentPageIndexChanged(0);
+        onCurrentPageIndexChanged(pageIndex);
 
     // 调整底部指示器位置
     bottomWidget->setGeometry(0, this->height() - 20, this->width(), 20);
 }
 
+void SlidePage::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+
+    // 隐藏期间滚动条范围不随页数更新，显示时按当前页恢复滚动位置
+    if (provider) {
+        scrollToCurrentPage();
+        updateVisiblePages(true);
+    }
+}
+
+/**
+ * @brief 缓存图片模式：在需要重绘的区域内绘制最多两页图片和背景
+ *
+ * 图片已按页面尺寸预缩放，drawPixmap 为 1:1 贴图；背景只填充图片以外的部分。
+ */
+void SlidePage::paintEvent(QPaintEvent *event)
+{
+    if (renderMode != PixmapMode) {
+        QWidget::paintEvent(event);
+        return;
+    }
+
+    QPainter painter(this);
+    const QRect area = pageArea();
+    const QRect dirty = event->rect();
+
+    // 底部指示器所在区域（指示器控件本身透明）
+    const QRect bottom(0, area.height(), this->width(), this->height() - area.height());
+    if (dirty.intersects(bottom))
+        painter.fillRect(bottom & dirty, palette().window());
+
+    const QRect dirtyArea = dirty & area;
+    if (dirtyArea.isEmpty())
+        return;
+    if (!provider || pageCount == 0 || this->width() <= 0) {
+        painter.fillRect(dirtyArea, pageBackground);
+        return;
+    }
+
+    const int first = pixmapOffset / this->width();
+    for (int index = first; index <= first + 1 && index < pageCount; ++index) {
+        const QRect pageRect = pageGeometry(index).translated(-pixmapOffset, 0);
+        const QRect target = pageRect & dirtyArea;
+        if (target.isEmpty())
+            continue;
+
+        const QPixmap pixmap = provider->pagePixmap(index);
+        QRect pixmapRect;
+        if (!pixmap.isNull()) {
+            pixmapRect = QRect(QPoint(0, 0), pixmap.size() / pixmap.devicePixelRatio());
+            pixmapRect.moveCenter(pageRect.center());
+        }
+
+        painter.save();
+        painter.setClipRegion(QRegion(target).subtracted(QRegion(pixmapRect)));
+        painter.fillRect(target, pageBackground);
+        painter.restore();
+
+        if (!pixmap.isNull() && pixmapRect.intersects(target))
+            painter.drawPixmap(pixmapRect.topLeft(), pixmap);
+    }
+}
+
+/**
+ * @brief 缓存图片模式：按下时停止动画，记录起点
+ */
+void SlidePage::mousePressEvent(QMouseEvent *event)
+{
+    if (renderMode != PixmapMode || event->button() != Qt::LeftButton || pageCount == 0) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+
+    offsetAnimation->stop();
+    pressedFlag = true;
+    pressX = event->x();
+    pressOffset = pixmapOffset;
+    pressTimer.start();
+}
+
+/**
+ * @brief 缓存图片模式：偏移跟随手指
+ */
+void SlidePage::mouseMoveEvent(QMouseEvent *event)
+{
+    if (renderMode != PixmapMode || !pressedFlag) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+
+    setPixmapOffset(pressOffset - (event->x() - pressX));
+}
+
+/**
+ * @brief 缓存图片模式：松开后动画滑动到目标页
+ *
+ * 与控件模式相同：300ms 内移动超过 20 像素视为轻扫，翻到相邻页；
+ * 否则视为拖动，停在最近的一页。
+ */
+void SlidePage::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (renderMode != PixmapMode || !pressedFlag || event->button() != Qt::LeftButton) {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+    pressedFlag = false;
+
+    const int width = this->width();
+    const int startIndex = (pressOffset + width / 2) / width;
+    const int moved = pressX - event->x();
+    int target;
+    if (pressTimer.elapsed() < 300 && qAbs(moved) > 20)
+        target = startIndex + (moved > 0 ? 1 : -1);
+    else
+        target = (pixmapOffset + width / 2) / width;
+    target = qBound(0, target, pageCount - 1);
+
+    offsetAnimation->stop();
+    offsetAnimation->setStartValue(pixmapOffset);
+    offsetAnimation->setEndValue(target * width);
+    offsetAnimation->start();
+
+    if (target != pageIndex) {
+        pageIndex = target;
+        emit currentPageIndexChanged(pageIndex);
+    }
+}
+
 /**
  * @brief 滚动条变化时计算当前页索引
  */
 void SlidePage::hScrollBarValueChanged(int)
 {
+    // 隐藏时滚动值可能被旧的范围截断，不据此修改当前页
+    if (provider && !isVisible())
+        return;
+
     // 当前滚动位置对应的页索引
     pageIndex = scrollArea->horizontalScrollBar()->value() / this->width();
 
@@ -140,6 +637,8 @@ void SlidePage::hScrollBarValueChanged(int)
     pageIndex = scrollArea->horizontalScrollBar()->value() >=
                 (pageIndex * this->width() + this->width() * 0.5)
                 ? pageIndex + 1 : pageIndex;
+
+    updateVisiblePages();
 }
 
 /**
@@ -215,6 +714,9 @@ void SlidePage::onTimerTimeout()
  */
 void SlidePage::onCurrentPageIndexChanged(int index)
 {
+    if (!indicatorText->isHidden())
+        indicatorText->setText(QString("%1 / %2").arg(index + 1).arg(pageCount));
+
     for (int i = 0; i < pageIndicator.count(); ++i) {
         // 当前页为高亮蓝色，其余灰色
         pageIndicator[i]->setPixmap(QPixmap(
@@ -16,6 +16,59 @@ Copyright © Deng Zhimao Co., Ltd. 1990-2021. All rights reserved.
 #include <QTimer>
 #include <QLabel>
 #include <QVector>
+#include <QPixmap>
+#include <QElapsedTimer>
+
+class QVariantAnimation;
+
+/**
+ * @brief SlidePage 页面提供者
+ *
+ * 页面数量很多（如相册）时不再一次性创建所有页面，而由提供者按需填充：
+ * SlidePage 只创建少量页面控件（当前页及两侧各 preloadDistance 页），
+ * 滑动时把离开窗口的控件解绑后重新绑定到新进入窗口的页，控件数量与总页数无关。
+ */
+class SlidePageProvider
+{
+public:
+    virtual ~SlidePageProvider() {}
+
+    /**
+     * @brief 总页数
+     */
+    virtual int pageCount() const = 0;
+
+    /**
+     * @brief 创建一个空白页面控件（只在 setProvider 时调用，数量固定）
+     */
+    virtual QWidget *createPage() = 0;
+
+    /**
+     * @brief 把页面控件绑定到第 index 页，填充内容
+     */
+    virtual void bindPage(QWidget *page, int index) = 0;
+
+    /**
+     * @brief 页面控件离开显示窗口，可在此释放内容（图片等）
+     */
+    virtual void unbindPage(QWidget *page, int index) { Q_UNUSED(page); Q_UNUSED(index); }
+
+    /**
+     * @brief 缓存图片模式：准备 [first, last] 页缩放到 size 以内的图片，其余页的图片可以释放
+     * @param current 当前页，应最先准备
+     *
+     * 图片准备好后由提供者的使用者调用 SlidePage::updatePage() 通知重绘。
+     */
+    virtual void preparePixmaps(int current, int first, int last, const QSize &size)
+    {
+        Q_UNUSED(current); Q_UNUSED(first); Q_UNUSED(last); Q_UNUSED(size);
+    }
+
+    /**
+     * @brief 缓存图片模式：第 index 页已准备好的图片，未准备好时返回空图片
+     */
+    virtual QPixmap pagePixmap(int index) const { Q_UNUSED(index); return QPixmap(); }
+};
 
 /**
  * @brief SlidePage
@@ -27,12 +80,20 @@ Copyright © Deng Zhimao Co., Ltd. 1990-2021. All rights reserved.
  *  2. 底部带小圆点分页指示器。
  *  3. 支持鼠标拖动/触摸滑动。
  *  4. 松开后自动滑动到最近页面，并带有动画效果。
+ *  5. 可通过 SlidePageProvider 按需加载页面，只保留当前页附近的页面控件。
+ *  6. 缓存图片模式（PixmapMode）：不使用页面控件和 QScrollArea，
+ *     拖动和动画时只把最多两张预缩放的图片按偏移量绘制到控件上。
  */
 class SlidePage : public QWidget
 {
     Q_OBJECT
 
 public:
+    enum RenderMode {
+        WidgetMode,   ///< 页面为子控件，QScroller 驱动 QScrollArea 滚动（默认）
+        PixmapMode    ///< 页面为提供者缓存的图片，由 SlidePage 自行处理拖动、动画和绘制
+    };
+
     explicit SlidePage(QWidget *parent = nullptr);  // 构造函数
     ~SlidePage();                                   // 析构函数
 
@@ -42,6 +103,50 @@ public:
      */
     void addPage(QWidget *page);
 
+    /**
+     * @brief 使用页面提供者（与 addPage 二选一）
+     * @param provider 由调用者管理生命周期，须比 SlidePage 存活更久；
+     *                 先于 SlidePage 销毁时，须先调用 setProvider(nullptr) 解除绑定
+     */
+    void setProvider(SlidePageProvider *provider);
+
+    /**
+     * @brief 提供者的页数或内容变化后重新加载，尽量保持当前页
+     */
+    void reloadPages();
+
+    /**
+     * @brief 提供者在 index 处插入了 count 页（提供者的数据须已更新）
+     *
+     * 已绑定的页面只调整位置，不重新绑定；当前显示的页面保持不变。
+     */
+    void insertPages(int index, int count = 1);
+
+    /**
+     * @brief 提供者移除了 index 起的 count 页（提供者的数据须已更新）
+     */
+    void removePages(int index, int count = 1);
+
+    /**
+     * @brief 当前页两侧预先绑定的页数（默认 1），需在 setProvider 之前设置
+     */
+    void setPreloadDistance(int distance);
+
+    /**
+     * @brief 设置绘制模式，PixmapMode 需要提供者实现 preparePixmaps/pagePixmap
+     *
+     * 软件光栅化（linuxfb）时 PixmapMode 每帧只有一次贴图：控件不透明
+     * （WA_OpaquePaintEvent），拖动时用 QWidget::scroll() 平移已绘制的内容，
+     * 只重绘新露出的窄条，不重新布局和绘制子控件。
+     */
+    void setRenderMode(RenderMode mode);
+    RenderMode getRenderMode() const { return renderMode; }
+
+    /**
+     * @brief 第 index 页的内容已更新（如图片准备好），在显示范围内时重绘该页
+     */
+    void updatePage(int index);
+
     /**
      * @brief 获取总页数
      */
@@ -66,6 +171,20 @@ protected:
      */
     void resizeEvent(QResizeEvent *event) override;
 
+    /**
+     * @brief 重载 showEvent
+     * 按需加载时页面在控件首次显示时才绑定，隐藏状态下不解码内容
+     */
+    void showEvent(QShowEvent *event) override;
+
+    /**
+     * @brief 缓存图片模式下的绘制和拖动处理
+     */
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
 private slots:
     /**
      * @brief 滚动条值变化槽函数
@@ -92,6 +211,15 @@ private slots:
     void onCurrentPageIndexChanged(int index);
 
 private:
+    void addIndicator();
+    void rebuildIndicator();
+    void updateVisiblePages(bool force = false);
+    void pagesChanged(int oldIndex);
+    QRect pageGeometry(int index) const;
+    QRect pageArea() const;
+    void scrollToCurrentPage();
+    void setPixmapOffset(int offset);
+
     /* ============= 核心界面结构 ============= */
     QScrollArea *scrollArea;       // 滚动容器，承载所有页面
     QWidget *mainWidget;           // 主容器，实际存放所有子页面
@@ -101,6 +229,7 @@ private:
     QWidget *bottomWidget;              // 底部区域容器
     QHBoxLayout *bottomHBoxLayout;      // 底部水平布局
     QVector<QLabel *> pageIndicator;    // 底部指示器圆点
+    QLabel *indicatorText;              // 页数过多时改为文字 "当前/总数"
 
     /* ============= 滑动相关 ============= */
     QScroller *scroller;          // Qt 内置滑动控制器
@@ -110,6 +239,23 @@ private:
     int pageIndex;                // 当前页面索引
     int pageCount;                // 总页面数量
     bool draggingFlag;            // 拖动标志位，true 表示当前为拖动
+
+    /* ============= 按需加载 ============= */
+    SlidePageProvider *provider;  // 页面提供者，为空时使用 addPage 添加的页面
+    QVector<QWidget *> pagePool;  // 复用的页面控件
+    QVector<int> pagePoolIndex;   // 各控件当前绑定的页索引，-1 表示空闲
+    int preloadDistance;          // 当前页两侧预先绑定的页数
+    int visibleCenter;            // 上次绑定时的中心页，-1 表示需要重新绑定
+
+    /* ============= 缓存图片模式 ============= */
+    RenderMode renderMode;        // 绘制模式
+    int pixmapOffset;             // 水平偏移（像素），第 i 页绘制在 i * width() - pixmapOffset
+    bool pressedFlag;             // 鼠标/触摸按下中
+    int pressX;                   // 按下时的横坐标
+    int pressOffset;              // 按下时的偏移
+    QElapsedTimer pressTimer;     // 按下时长，区分轻扫和拖动
+    QVariantAnimation *offsetAnimation; // 松手后的偏移动画
+    QColor pageBackground;        // 图片以外区域的背景色
 };
 
 #endif // SLIDEPAGE_H
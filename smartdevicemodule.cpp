@@ -1,18 +1,64 @@
 #include "smartdevicemodule.h"
-#include <QFile>
-#include <QTextStream>
+#include "ap3216cacquisition.h"
+#include "imuacquisition.h"
+#include "beeppatternplayer.h"
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+
+#include <string.h>
+#include <time.h>
 
 smartDeviceModule::smartDeviceModule(QObject *parent)
-    : QObject(parent), beepCount(0), beepTarget(0), beepState(false), interval(500)
+    : QObject(parent)
 {
+    // 外设路径只在启动时解析一次
+    m_peripherals.load();
+
+    // 注册并立即打开需要反复写入的属性文件，不存在的外设槽位为 -1，写入直接跳过
+    m_ledTriggerFile     = addSysFile(PeripheralRegistry::Led, "trigger");
+    m_ledBrightnessFile  = addSysFile(PeripheralRegistry::Led, "brightness");
+    m_alarmEnableFile    = addSysFile(PeripheralRegistry::Alarm, "enable");
+    m_beepBrightnessFile = addSysFile(PeripheralRegistry::Beep, "brightness");
+
+    qRegisterMetaType<Ap3216cSample>("Ap3216cSample");
+    qRegisterMetaType<Sensor6AxisBatch>("Sensor6AxisBatch");
+
+    // AP3216C 在独立线程中采集，样本排队送回本对象所在线程
+    m_ap3216c = new Ap3216cAcquisition(this);
+    m_ap3216c->setSysfsPaths(m_peripherals.attribute(PeripheralRegistry::Ap3216c, "als"),
+                             m_peripherals.attribute(PeripheralRegistry::Ap3216c, "ps"),
+                             m_peripherals.attribute(PeripheralRegistry::Ap3216c, "ir"));
+    m_ap3216c->setIioDeviceName(m_peripherals.iioName(PeripheralRegistry::Ap3216c));
+    m_ap3216c->setIioPaths(m_peripherals.iioDevicesDir(), m_peripherals.devDir());
+    connect(m_ap3216c, &Ap3216cAcquisition::sampleReady,
+            this, &smartDeviceModule::onAp3216cSample, Qt::QueuedConnection);
+    connect(m_ap3216c, &Ap3216cAcquisition::acquisitionError, this, [](const QString &msg) {
+        qDebug() << msg;
+    });
+
+    // 六轴传感器同样在独立线程中采集，按批送回
+    m_imu = new ImuAcquisition(this);
+    m_imu->setIioDeviceName(m_peripherals.iioName(PeripheralRegistry::Imu));
+    m_imu->setIioPaths(m_peripherals.iioDevicesDir(), m_peripherals.devDir());
+    m_imu->setFakeSource(m_peripherals.fakeSource(PeripheralRegistry::Imu));
+    connect(m_imu, &ImuAcquisition::samplesReady,
+            this, &smartDeviceModule::onImuSamples, Qt::QueuedConnection);
+    connect(m_imu, &ImuAcquisition::acquisitionError, this, [](const QString &msg) {
+        qDebug() << msg;
+    });
+
     // 初始化 LED 为手动控制
     setLedTrigger("none");
 
-    // 定时器用于控制 BEEP 闹钟节奏
-    connect(&timer, &QTimer::timeout, this, &smartDeviceModule::toggleBeep);
-    // 定时器用于ap3216C read data
-    connect(&readAp3216c_timer, &QTimer::timeout, this, &smartDeviceModule::timer_timeout);
+    // BEEP 闹钟节奏由内核触发器或独立线程驱动，播放完毕后通知界面
+    m_beepPlayer = new BeepPatternPlayer(m_peripherals.path(PeripheralRegistry::Beep), this);
+    connect(m_beepPlayer, &BeepPatternPlayer::finished,
+            this, &smartDeviceModule::alarmStopped, Qt::QueuedConnection);
+
+    // 配置了日志目录时（默认不配置），采集到的样本同时写入传感器日志
+    if (!m_peripherals.logDir().isEmpty())
+        startLogging(m_peripherals.logDir(), m_peripherals.logMaxSegments());
 }
 
 smartDeviceModule::~smartDeviceModule()
@@ -20,30 +66,37 @@ smartDeviceModule::~smartDeviceModule()
     // 析构时关闭所有外设
     turnLedOff();
     turnAlarmOff();
+    m_beepPlayer->stop();
     beepOff();
-    if (readAp3216c_timer.isActive())
-        readAp3216c_timer.stop();
+    m_ap3216c->stopAcquisition();
+    m_imu->stopAcquisition();
+    m_sensorLog.close();
 }
 
 /**
  * @brief writeSysFile
- * 写入 sysfs 文件的统一接口
- * @param path 文件路径
+ * 写入 sysfs 文件的统一接口，每次写入只有一次 pwrite 系统调用
+ * @param file 属性文件槽位
  * @param value 写入值
  * @return true 成功 / false 失败
  */
-bool smartDeviceModule::writeSysFile(const QString &path, const QString &value)
+bool smartDeviceModule::writeSysFile(int file, const char *value)
 {
-    QFile file(path);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qDebug() << "Cannot open" << path;
-        return false;
-    }
+    return m_sysfs.write(file, value, static_cast<int>(strlen(value)));
+}
+
+/**
+ * @brief 注册外设的属性文件并立即打开
+ * @return 槽位号，外设不存在时返回 -1
+ */
+int smartDeviceModule::addSysFile(PeripheralRegistry::Peripheral peripheral, const char *attribute)
+{
+    if (!m_peripherals.isPresent(peripheral))
+        return -1;
 
-    QTextStream out(&file);
-    out << value;  // 写入文件
-    file.close();
-    return true;
+    const int slot = m_sysfs.add(m_peripherals.attribute(peripheral, attribute));
+    m_sysfs.handle(slot);
+    return slot;
 }
 
 // ========================
@@ -51,20 +104,17 @@ bool smartDeviceModule::writeSysFile(const QString &path, const QString &value)
 // ========================
 void smartDeviceModule::setLedTrigger(const QString &mode)
 {
-    QString path = QString(ledPath) + "trigger";
-    writeSysFile(path, mode);
+    m_sysfs.write(m_ledTriggerFile, mode.toLatin1());
 }
 
 void smartDeviceModule::turnLedOn()
 {
-    QString path = QString(ledPath) + "brightness";
-    writeSysFile(path, "1");
+    writeSysFile(m_ledBrightnessFile, "1");
 }
 
 void smartDeviceModule::turnLedOff()
 {
-    QString path = QString(ledPath) + "brightness";
-    writeSysFile(path, "0");
+    writeSysFile(m_ledBrightnessFile, "0");
 }
 
 // ========================
@@ -72,12 +122,12 @@ void smartDeviceModule::turnLedOff()
 // ========================
 void smartDeviceModule::turnAlarmOn()
 {
-    writeSysFile(QString(alarmPath) + "enable", "1");
+    writeSysFile(m_alarmEnableFile, "1");
 }
 
 void smartDeviceModule::turnAlarmOff()
 {
-    writeSysFile(QString(alarmPath) + "enable", "0");
+    writeSysFile(m_alarmEnableFile, "0");
 }
 
 // ========================
@@ -85,118 +135,146 @@ void smartDeviceModule::turnAlarmOff()
 // ========================
 void smartDeviceModule::beepOn()
 {
-    writeSysFile(QString(beepPath) + "brightness", "1");
+    writeSysFile(m_beepBrightnessFile, "1");
 }
 
 void smartDeviceModule::beepOff()
 {
-    writeSysFile(QString(beepPath) + "brightness", "0");
+    writeSysFile(m_beepBrightnessFile, "0");
 }
 
 // ========================
 // 闹钟控制
 // ========================
+/**
+ * @brief 开始闹钟
+ * @param times 滴滴次数
+ * @param intervalMs 每次响和停的时长（毫秒）
+ */
 void smartDeviceModule::startAlarm(int times, int intervalMs)
 {
     if (times <= 0) return;
+    if (!m_peripherals.isPresent(PeripheralRegistry::Beep)) {
+        qDebug() << "BEEP not available";
+        return;
+    }
 
-    beepTarget = times * 2; // 每次滴滴包含 BEEP_ON + BEEP_OFF 两个状态
-    beepCount = 0;
-    beepState = false;
-    interval = intervalMs;
-
-    timer.start(interval);
+    m_beepPlayer->play(BeepPatternPlayer::beep(intervalMs, intervalMs), times);
 }
 
 void smartDeviceModule::stopAlarm()
 {
-    timer.stop();
+    m_beepPlayer->stop();
     beepOff();
-    beepState = false;
-    beepCount = 0;
 
     emit alarmStopped(); // 发信号通知外部（MainWindow）
 }
 
-void smartDeviceModule::toggleBeep()
-{
-    if (beepCount >= beepTarget) {
-        stopAlarm();  // 完成目标次数自动停止
-        return;
-    }
-
-    if (beepState) {
-        beepOff();
-        beepState = false;
-    } else {
-        beepOn();
-        beepState = true;
-    }
-
-    beepCount++;
-}
-
 
 /*AP3216C*/
 /**
  * @brief 启动或停止传感器数据采集
  * @param start true=启动，false=停止
+ * @param intervalMs 数据静止时的最大采样间隔（毫秒），有变化时自动加快到 10 ms
  */
-void smartDeviceModule::setCapture(bool start)
-{
-    if (start)
-        readAp3216c_timer.start(1000);  // 1秒更新一次
-    else
-        readAp3216c_timer.stop();
-}
-
-/* 模拟读取ALS数据 */
-QString smartDeviceModule::readAlsData()
+void smartDeviceModule::setCapture(bool start, int intervalMs)
 {
-    return readSensorValue(AP3216C_ALS_PATH);
+    m_ap3216c->stopAcquisition();
+    if (start) {
+        m_ap3216c->setIntervalRange(10, intervalMs);
+        m_ap3216c->startAcquisition();
+    }
 }
 
-/* 模拟读取PS数据 */
-QString smartDeviceModule::readPsData()
+/**
+ * @brief 墙钟时间与单调时钟之差：样本时间为单调时钟，写日志时换算为墙钟时间，便于跨重启查询
+ */
+static qint64 realtimeOffsetUs()
 {
-    return readSensorValue(AP3216C_PS_PATH);
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    const qint64 monotonicNowUs = static_cast<qint64>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+    return sensorLogRealtimeUs() - monotonicNowUs;
 }
 
-/* 模拟读取IR数据 */
-QString smartDeviceModule::readIrData()
+/**
+ * @brief 六轴采集启停
+ * @param start true=启动 false=停止
+ * @param rateHz 采样率，限制在 100~1000 Hz
+ * @param filtered 是否启用滤波级（低通/高通/姿态融合）
+ */
+void smartDeviceModule::setImuCapture(bool start, int rateHz, bool filtered)
 {
-    return readSensorValue(AP3216C_IR_PATH);
+    m_imu->stopAcquisition();
+    if (start) {
+        m_imu->setSampleRate(rateHz);
+        m_imu->setFilterEnabled(filtered);
+        m_imu->startAcquisition();
+    }
 }
 
-/* 定时器回调：读取传感器并发射信号 */
-void smartDeviceModule::timer_timeout()
+/**
+ * @brief 采集线程送来的样本：写入日志后转发给界面
+ */
+void smartDeviceModule::onAp3216cSample(const Ap3216cSample &sample)
 {
+    if (m_sensorLog.isOpen()) {
+        SensorLogRecord record;
+        memset(&record, 0, sizeof(record));
+        record.timestampUs = sample.timestampUs + realtimeOffsetUs();
+        record.type = SensorLogAp3216c;
+        record.values[0] = sample.als;
+        record.values[1] = sample.ps;
+        record.values[2] = sample.ir;
+        m_sensorLog.append(record);
+    }
 
-    Ap3216cData data;
-    data.als = readAlsData();
-    data.ps  = readPsData();
-    data.ir  = readIrData();
-    emit ap3216cDataUpdated(data);  // 发射结构体数据
+    emit ap3216cSampleReady(sample);
 }
 
-
-// 通用文件读取
-QString smartDeviceModule::readSensorValue(const QString &filePath)
+/**
+ * @brief 六轴采集线程送来的一批样本：逐条写入日志后整批转发给界面
+ */
+void smartDeviceModule::onImuSamples(const Sensor6AxisBatch &batch)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qDebug() << "Open file error:" << filePath;
-        return "open file error!";
+    if (m_sensorLog.isOpen()) {
+        const qint64 offsetUs = realtimeOffsetUs();
+
+        SensorLogRecord record;
+        memset(&record, 0, sizeof(record));
+        record.type = SensorLogImu;
+        // ax..gz 为传感器测量值（滤波级只填入 roll/pitch），不记录姿态
+        for (const Sensor6AxisData &sample : batch) {
+            record.timestampUs = sample.timestampUs + offsetUs;
+            record.values[0] = sample.ax;
+            record.values[1] = sample.ay;
+            record.values[2] = sample.az;
+            record.values[3] = sample.gx;
+            record.values[4] = sample.gy;
+            record.values[5] = sample.gz;
+            m_sensorLog.append(record);
+        }
     }
 
-    QByteArray buf = file.readAll();  // 读取整个文件内容
-    file.close();
+    emit imuSamplesReady(batch);
+}
 
-    if (buf.isEmpty()) {
-        qDebug() << "Read file error or file empty:" << filePath;
-        return "read data error!";
+/**
+ * @brief 开始记录传感器日志
+ * @param dir 日志目录，不存在时自动创建
+ * @param maxSegments 保留的段文件数
+ */
+bool smartDeviceModule::startLogging(const QString &dir, int maxSegments)
+{
+    if (!QDir().mkpath(dir)) {
+        qDebug() << "Cannot create log dir" << dir;
+        return false;
     }
+    return m_sensorLog.open(QFile::encodeName(dir).constData(), 256,
+                            static_cast<uint32_t>(qMax(1, maxSegments)));
+}
 
-    QString value = QString(buf).trimmed();  // 去掉换行符和空白
-    return value;
+void smartDeviceModule::stopLogging()
+{
+    m_sensorLog.close();
 }
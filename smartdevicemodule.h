@@ -4,6 +4,16 @@
 #include <QObject>
 #include <QTimer>
 #include <QString>
+#include <QMetaType>
+#include <QVector>
+
+#include "sysfsfilecache.h"
+#include "sensorlog.h"
+#include "peripheralregistry.h"
+
+class Ap3216cAcquisition;
+class ImuAcquisition;
+class BeepPatternPlayer;
 
 /*
 传感器	典型范围	单位/意义
@@ -11,37 +21,39 @@ ALS	0 ~ 65535	环境光强，ADC值，可换算 Lux
 PS	0 / 1 或 0~1023	接近状态，1表示物体靠近
 IR	0 ~ 1023	红外光强度，辅助检测距离
 */
-// ====== AP3216C sysfs 文件路径宏 ======
-#define AP3216C_BASE_PATH     "/sys/class/misc/ap3216c/"
-#define AP3216C_IR_PATH       AP3216C_BASE_PATH "ir"
-#define AP3216C_PS_PATH       AP3216C_BASE_PATH "ps"
-#define AP3216C_ALS_PATH      AP3216C_BASE_PATH "als"
-
-// 设置各外设 sysfs 路径
-#define	ledPath    "/sys/class/leds/sys-led/"
-#define	alarmPath  "/sys/class/alarm/alarm0/" // 如果系统有 ALARM 外设
-#define beepPath   "/sys/class/leds/beep/"
+// 各外设的 sysfs 路径见 config/peripherals.ini（PeripheralRegistry）
 
 /* 传感器数据结构体 */
-struct Ap3216cData {
-    QString als;  // 光照强度
-    QString ps;   // 距离
-    QString ir;   // 红外
+struct Ap3216cSample {
+    quint16 als = 0;          // 光照强度
+    quint16 ps = 0;           // 距离
+    quint16 ir = 0;           // 红外
+    qint64 timestampUs = 0;   // 采样时间（CLOCK_MONOTONIC，微秒）
 };
+Q_DECLARE_METATYPE(Ap3216cSample)
 
+/* 六轴（加速度计 + 陀螺仪）样本，紧凑布局，可直接按批传递 */
 struct Sensor6AxisData {
-    QString ax;
-    QString ay;
-    QString az;
-    QString gx;
-    QString gy;
-    QString gz;
+    float ax = 0;             // 加速度 (g)
+    float ay = 0;
+    float az = 0;
+    float gx = 0;             // 角速度 (°/s)
+    float gy = 0;
+    float gz = 0;
+    float roll = 0;           // 姿态（°），滤波级互补融合的结果，未启用滤波时为 0
+    float pitch = 0;
+    qint64 timestampUs = 0;   // 采样时间（CLOCK_MONOTONIC，微秒）
 };
+Q_DECLARE_TYPEINFO(Sensor6AxisData, Q_PRIMITIVE_TYPE);
+
+/* 一批六轴样本，按时间顺序 */
+typedef QVector<Sensor6AxisData> Sensor6AxisBatch;
+Q_DECLARE_METATYPE(Sensor6AxisBatch)
 
 /**
  * @brief The smartDeviceModule class
  * 封装系统硬件外设（LED、BEEP、ALARM）的控制
- * 继承 QObject 以便使用 QTimer 和信号槽
+ * 继承 QObject 以便使用信号槽
  */
 class smartDeviceModule : public QObject
 {
@@ -74,35 +86,53 @@ public:
     void startAlarm(int times, int intervalMs = 500); // times: 滴滴次数, intervalMs: 间隔毫秒
     void stopAlarm();                                 // 停止闹钟
 
-	/* ap3216c 启停采集 */
-    void setCapture(bool start);
-    QString readSensorValue(const QString &filePath);
-    void timer_timeout();
+    // 启动时读取的外设映射表
+    const PeripheralRegistry &peripherals() const { return m_peripherals; }
+
+    // sysfs 系统调用统计
+    const SysfsFileCache::Counters &sysfsCounters() const { return m_sysfs.counters(); }
+
+	/* ap3216c 启停采集（独立采集线程），intervalMs 为数据静止时的最大采样间隔 */
+    void setCapture(bool start, int intervalMs = 1000);
+
+    /* 传感器样本写入二进制日志（格式见 sensorlog.h），dir 为日志目录，
+       maxSegments 为保留的 1 MiB 段文件数 */
+    bool startLogging(const QString &dir, int maxSegments = 64);
+    void stopLogging();
+    bool isLogging() const { return m_sensorLog.isOpen(); }
+
+    /* 六轴采集启停（独立采集线程），rateHz 为采样率（100~1000 Hz），
+       filtered 为 true 时在采集线程中按批滤波并计算姿态（见 imufilter.h） */
+    void setImuCapture(bool start, int rateHz = 200, bool filtered = true);
 signals:
     void alarmStopped();  									// 闹钟完成时发送
-    void ap3216cDataUpdated(const Ap3216cData &data);	    /* 当传感器数据更新时发射 */
+    void ap3216cSampleReady(const Ap3216cSample &sample);	/* 当传感器数据更新时发射 */
+    void imuSamplesReady(const Sensor6AxisBatch &batch);    /* 一批六轴样本（默认每 20 ms 一批） */
 
 private slots:
-    void toggleBeep();  // 定时器槽函数，切换 BEEP 状态（开/关）
+    void onAp3216cSample(const Ap3216cSample &sample);  // 采集线程样本：写日志并转发
+    void onImuSamples(const Sensor6AxisBatch &batch);   // 六轴采集线程样本：写日志并转发
 
 private:
 
-    QTimer timer;       // 用于闹钟 BEEP 间隔控制
-    int beepCount;      // 当前滴滴次数计数
-    int beepTarget;     // 目标滴滴次数
-    bool beepState;     // 当前 BEEP 状态：true=响，false=停
-    int interval;       // 间隔时间（毫秒）
+    BeepPatternPlayer *m_beepPlayer;  // BEEP 节奏播放（内核触发器或独立线程）
 
-    QTimer readAp3216c_timer;
+    Ap3216cAcquisition *m_ap3216c;  // AP3216C 采集线程
+    ImuAcquisition *m_imu;          // 六轴采集线程
+    SensorLogWriter m_sensorLog;    // 传感器二进制日志
 
-    /* 模拟读取硬件数据 */
-    QString readAlsData();
-    QString readPsData();
-    QString readIrData();
     // ========================
     // 工具函数
     // ========================
-    bool writeSysFile(const QString &path, const QString &value);  // 写入 sysfs 文件
+    bool writeSysFile(int file, const char *value);  // 写入 sysfs 文件（file 为 m_sysfs 槽位）
+    int addSysFile(PeripheralRegistry::Peripheral peripheral, const char *attribute); // 注册并打开属性文件
+
+    PeripheralRegistry m_peripherals; // 外设映射表（构造时读取一次）
+    SysfsFileCache m_sysfs;     // 常驻的 sysfs 句柄
+    int m_ledTriggerFile;       // LED trigger
+    int m_ledBrightnessFile;    // LED brightness
+    int m_alarmEnableFile;      // ALARM enable
+    int m_beepBrightnessFile;   // BEEP brightness
 };
 
 #endif // SMARTDEVICEMODULE_H
@@ -0,0 +1,69 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief 无锁单生产者/单消费者队列
+ *
+ * - 固定容量（必须为 2 的幂），运行期间不分配内存
+ * - push() 只能由一个生产者线程调用，pop() 只能由一个消费者线程调用
+ * - 队列满时 push() 返回 false，由调用者决定丢弃或重试
+ */
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity 必须为 2 的幂");
+
+public:
+    SpscQueue() : m_head(0), m_tail(0) {}
+
+    /**
+     * @brief 生产者：入队
+     * @return false=队列已满
+     */
+    bool push(T &&item)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= Capacity)
+            return false;
+
+        m_items[tail & (Capacity - 1)] = std::move(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 消费者：出队
+     * @return false=队列为空
+     */
+    bool pop(T &item)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+
+        T &slot = m_items[head & (Capacity - 1)];
+        item = std::move(slot);
+        slot = T(); // 在消费者线程释放槽位持有的资源
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool isEmpty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return Capacity; }
+
+private:
+    T m_items[Capacity];
+    std::atomic<size_t> m_head;             ///< 消费者读位置
+    char m_pad[64];                         ///< 读写位置分处不同缓存行，避免伪共享
+    std::atomic<size_t> m_tail;             ///< 生产者写位置
+};
+
+#endif // SPSCQUEUE_H
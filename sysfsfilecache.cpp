@@ -0,0 +1,210 @@
+#include "sysfsfilecache.h"
+
+#include <QFile>
+#include <QDebug>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+SysfsFileCache::~SysfsFileCache()
+{
+    closeAll();
+}
+
+int SysfsFileCache::add(const QString &path, Access access)
+{
+    Entry entry;
+    entry.path = path;
+    entry.access = access;
+    entry.nativePath = QFile::encodeName(path);
+    m_entries.append(entry);
+    return m_entries.size() - 1;
+}
+
+void SysfsFileCache::closeAll()
+{
+    for (Entry &entry : m_entries)
+        closeEntry(entry);
+}
+
+/**
+ * @brief 需要时打开 fd
+ */
+bool SysfsFileCache::ensureOpen(Entry &entry)
+{
+    if (entry.fd >= 0)
+        return true;
+
+    m_counters.opens++;
+    const int flags = entry.access == Read ? O_RDONLY : O_WRONLY;
+    entry.fd = ::open(entry.nativePath.constData(), flags | O_CLOEXEC);
+    if (entry.fd < 0) {
+        if (!entry.reportedError) {
+            qDebug() << "Cannot open" << entry.path << strerror(errno);
+            entry.reportedError = true;
+        }
+        return false;
+    }
+
+    entry.reportedError = false;
+    return true;
+}
+
+void SysfsFileCache::closeEntry(Entry &entry)
+{
+    if (entry.fd < 0)
+        return;
+
+    ::close(entry.fd);
+    entry.fd = -1;
+    m_counters.closes++;
+}
+
+/**
+ * @brief pwrite 到偏移 0；设备失效时重新打开并重试一次
+ */
+bool SysfsFileCache::write(int slot, const char *data, int size)
+{
+    if (slot < 0 || slot >= m_entries.size())
+        return false;
+
+    Entry &entry = m_entries[slot];
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!ensureOpen(entry))
+            break;
+
+        ssize_t n;
+        do {
+            m_counters.writes++;
+            n = ::pwrite(entry.fd, data, static_cast<size_t>(size), 0);
+        } while (n < 0 && errno == EINTR);
+
+        if (n == size)
+            return true;
+
+        if (!recoverable(entry, n < 0 ? errno : EIO, attempt))
+            break;
+    }
+
+    m_counters.failures++;
+    return false;
+}
+
+/**
+ * @brief pread 偏移 0；设备失效时重新打开并重试一次
+ */
+int SysfsFileCache::read(int slot, char *buf, int size)
+{
+    if (slot < 0 || slot >= m_entries.size())
+        return -1;
+
+    Entry &entry = m_entries[slot];
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!ensureOpen(entry))
+            break;
+
+        ssize_t n;
+        do {
+            m_counters.reads++;
+            n = ::pread(entry.fd, buf, static_cast<size_t>(size), 0);
+        } while (n < 0 && errno == EINTR);
+
+        if (n >= 0)
+            return static_cast<int>(n);
+
+        if (!recoverable(entry, errno, attempt))
+            break;
+    }
+
+    m_counters.failures++;
+    return -1;
+}
+
+bool SysfsFileCache::readUInt16(int slot, quint16 &value)
+{
+    char buf[16];
+    int n = read(slot, buf, sizeof(buf));
+    if (n <= 0)
+        return false;
+
+    int i = 0;
+    while (i < n && (buf[i] == ' ' || buf[i] == '\t'))
+        i++;
+
+    quint32 v = 0;
+    int digits = 0;
+    for (; i < n && buf[i] >= '0' && buf[i] <= '9'; i++, digits++) {
+        v = v * 10 + static_cast<quint32>(buf[i] - '0');
+        if (v > 0xFFFF)
+            v = 0xFFFF;   // 饱和，避免溢出
+    }
+    if (digits == 0)
+        return false;
+
+    value = static_cast<quint16>(v);
+    return true;
+}
+
+bool SysfsFileCache::readInt32(int slot, qint32 &value)
+{
+    char buf[16];
+    int n = read(slot, buf, sizeof(buf));
+    if (n <= 0)
+        return false;
+
+    int i = 0;
+    while (i < n && (buf[i] == ' ' || buf[i] == '\t'))
+        i++;
+
+    bool negative = false;
+    if (i < n && (buf[i] == '-' || buf[i] == '+')) {
+        negative = buf[i] == '-';
+        i++;
+    }
+
+    qint64 v = 0;
+    int digits = 0;
+    for (; i < n && buf[i] >= '0' && buf[i] <= '9'; i++, digits++) {
+        v = v * 10 + (buf[i] - '0');
+        if (v > 0x80000000LL)
+            v = 0x80000000LL;   // 饱和，避免溢出
+    }
+    if (digits == 0)
+        return false;
+
+    if (negative)
+        v = -v;
+    value = static_cast<qint32>(qBound<qint64>(INT32_MIN, v, INT32_MAX));
+    return true;
+}
+
+int SysfsFileCache::handle(int slot)
+{
+    if (slot < 0 || slot >= m_entries.size())
+        return -1;
+
+    Entry &entry = m_entries[slot];
+    return ensureOpen(entry) ? entry.fd : -1;
+}
+
+/**
+ * @brief 设备失效类错误关闭 fd 以便重新打开，其余错误（如属性值非法）直接失败
+ */
+bool SysfsFileCache::recoverable(Entry &entry, int err, int attempt)
+{
+    if (err != ENODEV && err != EBADF && err != ESTALE) {
+        qDebug() << (entry.access == Read ? "Read" : "Write") << entry.path
+                 << "failed:" << strerror(err);
+        return false;
+    }
+
+    closeEntry(entry);
+    if (attempt == 0)
+        m_counters.reopens++;
+    return true;
+}
@@ -0,0 +1,111 @@
+#ifndef SYSFSFILECACHE_H
+#define SYSFSFILECACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+
+/**
+ * @brief sysfs 属性文件句柄缓存
+ *
+ * 控制 LED/BEEP 等外设时反复写同一批属性文件（brightness、trigger、enable），
+ * 采集传感器时反复读同一批属性文件（als、ps、ir），每次 open/读写/close
+ * 需要 3 次系统调用。本类为每个属性保持一个打开的 fd，
+ * 写入只做一次 pwrite(fd, ..., 0)，读取只做一次 pread(fd, ..., 0)：
+ * - 属性通过 add() 注册，得到槽位号，之后按槽位号访问，无需拼接路径或查表
+ * - fd 延迟打开；打开失败时下次写入再尝试
+ * - 读写返回 ENODEV/EBADF/ESTALE（设备被移除或驱动重新加载）时重新打开并重试一次
+ * - 记录系统调用次数，便于对比优化效果
+ *
+ * 非线程安全，每个实例只应在一个线程中使用。
+ */
+class SysfsFileCache
+{
+public:
+    /**
+     * @brief 系统调用计数
+     */
+    struct Counters {
+        quint64 opens = 0;     ///< open() 次数（含重新打开）
+        quint64 closes = 0;    ///< close() 次数
+        quint64 writes = 0;    ///< pwrite() 次数
+        quint64 reads = 0;     ///< pread() 次数
+        quint64 reopens = 0;   ///< 因错误重新打开的次数
+        quint64 failures = 0;  ///< 最终失败的操作次数
+    };
+
+    SysfsFileCache() = default;
+    ~SysfsFileCache();
+
+    SysfsFileCache(const SysfsFileCache &) = delete;
+    SysfsFileCache &operator=(const SysfsFileCache &) = delete;
+
+    enum Access {
+        Write,  ///< 只写（控制属性）
+        Read    ///< 只读（传感器属性）
+    };
+
+    /**
+     * @brief 注册一个属性文件（不立即打开）
+     * @return 槽位号，用于 write()/read()
+     */
+    int add(const QString &path, Access access = Write);
+
+    /**
+     * @brief 从偏移 0 写入属性值
+     * @return true=写入成功
+     */
+    bool write(int slot, const char *data, int size);
+    bool write(int slot, const QByteArray &value) { return write(slot, value.constData(), value.size()); }
+
+    /**
+     * @brief 从偏移 0 读取属性值（sysfs 每次 pread 都重新生成内容）
+     * @return 读取的字节数，失败返回 -1
+     */
+    int read(int slot, char *buf, int size);
+
+    /**
+     * @brief 读取并解析十进制整数属性（栈缓冲区，无堆分配）
+     * @param value 解析结果，超出范围时取 65535
+     * @return 读取失败或内容不是数字返回false
+     */
+    bool readUInt16(int slot, quint16 &value);
+
+    /**
+     * @brief 读取并解析有符号十进制整数属性（如 IIO 的 in_accel_x_raw）
+     * @param value 解析结果，超出范围时饱和到 qint32 上下限
+     */
+    bool readInt32(int slot, qint32 &value);
+
+    /**
+     * @brief 获取槽位的 fd（需要时打开），用于 poll()
+     * @return 打开失败返回 -1
+     */
+    int handle(int slot);
+
+    /**
+     * @brief 关闭所有 fd（槽位保留，下次访问时重新打开）
+     */
+    void closeAll();
+
+    QString path(int slot) const { return m_entries.at(slot).path; }
+    const Counters &counters() const { return m_counters; }
+
+private:
+    struct Entry {
+        QString path;
+        QByteArray nativePath;  ///< 预先编码的文件系统路径
+        Access access = Write;
+        int fd = -1;
+        bool reportedError = false; ///< 已打印过打开失败，避免日志刷屏
+    };
+
+    bool ensureOpen(Entry &entry);
+    void closeEntry(Entry &entry);
+    bool recoverable(Entry &entry, int err, int attempt); ///< 是否应重新打开后重试
+
+    QVector<Entry> m_entries;
+    Counters m_counters;
+};
+
+#endif // SYSFSFILECACHE_H
@@ -0,0 +1,187 @@
+/*
+ * serial_replay：无硬件回放串口抓包
+ *
+ * 1. openpty() 创建伪终端，从设备端设置为 raw 模式，并打印（可选链接）其路径；
+ * 2. 应用打开该路径作为串口（例如在串口下拉框中选择或通过 -l 固定路径）；
+ * 3. 按记录时间戳把 Rx 方向（设备 -> 本机）的数据写入主设备端，
+ *    应用发出的数据被读取并丢弃，只做统计。
+ *
+ * -s 0 表示不等待，尽可能快地回放，用于测量接收路径的最大吞吐量。
+ */
+#include "serialcapture.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "用法: %s [-s 倍速] [-n 循环次数] [-d 启动延时ms] [-l 链接路径] capture.scap\n"
+            "  -s  回放倍速，默认 1.0；0 表示不等待全速回放\n"
+            "  -n  循环回放次数，默认 1\n"
+            "  -d  开始回放前等待应用打开串口的时间，默认 3000 ms\n"
+            "  -l  为伪终端创建符号链接（如 /tmp/ttyREPLAY）\n",
+            prog);
+}
+
+/**
+ * @brief 读取并丢弃应用写入的数据，最多等待 timeoutMs
+ */
+static uint64_t drainMaster(int master, int timeoutMs)
+{
+    uint64_t total = 0;
+    struct pollfd pfd = { master, POLLIN, 0 };
+
+    while (poll(&pfd, 1, timeoutMs) > 0 && (pfd.revents & POLLIN)) {
+        char buf[4096];
+        ssize_t n = read(master, buf, sizeof(buf));
+        if (n <= 0)
+            break;
+        total += static_cast<uint64_t>(n);
+        timeoutMs = 0;   // 已有数据时只把当前可读的读完
+    }
+    return total;
+}
+
+/**
+ * @brief 写满为止（伪终端缓冲区满时等待应用读取）
+ */
+static bool writeAll(int master, const uint8_t *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t n = write(master, data, size);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN) {
+                struct pollfd pfd = { master, POLLOUT, 0 };
+                poll(&pfd, 1, 100);
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    double speed = 1.0;
+    int loops = 1;
+    int startDelayMs = 3000;
+    const char *linkPath = nullptr;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:n:d:l:h")) != -1) {
+        switch (opt) {
+        case 's': speed = atof(optarg); break;
+        case 'n': loops = atoi(optarg); break;
+        case 'd': startDelayMs = atoi(optarg); break;
+        case 'l': linkPath = optarg; break;
+        default: usage(argv[0]); return 1;
+        }
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    SerialCaptureReader reader;
+    if (!reader.open(argv[optind])) {
+        fprintf(stderr, "无法打开抓包文件: %s\n", argv[optind]);
+        return 1;
+    }
+
+    // ========== 创建伪终端 ==========
+    int master = -1, slave = -1;
+    char slaveName[128];
+    if (openpty(&master, &slave, slaveName, nullptr, nullptr) < 0) {
+        perror("openpty");
+        return 1;
+    }
+
+    struct termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+    if (linkPath) {
+        unlink(linkPath);
+        if (symlink(slaveName, linkPath) < 0)
+            perror("symlink");
+    }
+
+    printf("伪终端: %s%s%s\n", slaveName, linkPath ? " -> " : "", linkPath ? linkPath : "");
+    printf("%d ms 后开始回放...\n", startDelayMs);
+    fflush(stdout);
+    drainMaster(master, startDelayMs);
+
+    // ========== 按时间戳回放 ==========
+    uint64_t rxBytes = 0, rxRecords = 0, txBytes = 0;
+    const uint64_t beginNs = serialCaptureMonotonicNs();
+
+    for (int loop = 0; loop < loops; loop++) {
+        reader.rewind();
+        const uint64_t loopStartNs = serialCaptureMonotonicNs();
+
+        SerialCaptureReader::Record rec;
+        while (reader.next(rec)) {
+            if (rec.direction != SerialCaptureRx)
+                continue;   // 应用发出的数据由应用自己产生
+
+            if (speed > 0) {
+                uint64_t due = loopStartNs + static_cast<uint64_t>(rec.timestampNs / speed);
+                for (;;) {
+                    uint64_t now = serialCaptureMonotonicNs();
+                    if (now >= due)
+                        break;
+                    // 等待期间顺便读走应用发来的数据
+                    int waitMs = static_cast<int>((due - now) / 1000000);
+                    if (waitMs > 0) {
+                        txBytes += drainMaster(master, waitMs);
+                    } else {
+                        struct timespec ts = { 0, static_cast<long>(due - now) };
+                        nanosleep(&ts, nullptr);
+                    }
+                }
+            }
+
+            if (!writeAll(master, rec.data.data(), rec.data.size())) {
+                perror("write");
+                return 1;
+            }
+            rxBytes += rec.data.size();
+            rxRecords++;
+            txBytes += drainMaster(master, 0);
+        }
+    }
+
+    // 等待应用读完最后的数据
+    tcdrain(master);
+    txBytes += drainMaster(master, 500);
+
+    const double seconds = (serialCaptureMonotonicNs() - beginNs) / 1e9;
+    printf("回放完成: %llu 条记录, %llu 字节, 用时 %.3f s, %.1f KB/s; 应用发出 %llu 字节\n",
+           static_cast<unsigned long long>(rxRecords),
+           static_cast<unsigned long long>(rxBytes),
+           seconds,
+           seconds > 0 ? rxBytes / seconds / 1024.0 : 0.0,
+           static_cast<unsigned long long>(txBytes));
+
+    if (linkPath)
+        unlink(linkPath);
+    close(slave);
+    close(master);
+    return 0;
+}
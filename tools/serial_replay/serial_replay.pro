@@ -0,0 +1,18 @@
+# 串口抓包回放工具：创建伪终端，按抓包时间节奏把接收方向的数据写给应用
+# 构建: qmake && make
+# 用法: ./serial_replay [-s 倍速] [-n 循环次数] [-d 启动延时ms] [-l 链接路径] capture.scap
+
+TEMPLATE = app
+TARGET = serial_replay
+CONFIG += console c++14
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += ../..
+LIBS += -lutil
+
+SOURCES += \
+    main.cpp \
+    ../../serialcapture.cpp
+
+HEADERS += \
+    ../../serialcapture.h
@@ -0,0 +1,165 @@
+#include "logview.h"
+
+#include <QPainter>
+#include <QWheelEvent>
+
+LogView::LogView(QWidget *parent)
+    : QWidget(parent),
+      m_first(0),
+      m_count(0),
+      m_scrollBack(0),
+      m_droppedLines(0),
+      m_dirty(false)
+{
+    m_lines.resize(2000);           // 默认保留 2000 行
+
+    // 自己绘制整个区域，跳过背景擦除
+    setAttribute(Qt::WA_OpaquePaintEvent, true);
+
+    m_refreshTimer.setSingleShot(true);
+    m_refreshTimer.setInterval(1000 / 30); // 最多 30 Hz 重绘
+    connect(&m_refreshTimer, &QTimer::timeout, this, [=]() {
+        if (m_dirty) {
+            m_dirty = false;
+            update();
+        }
+    });
+}
+
+LogView::~LogView()
+{
+}
+
+/**
+ * @brief 追加日志，按换行拆分后逐行写入
+ */
+void LogView::appendLine(const QString &line)
+{
+    if (!line.contains(QLatin1Char('\n'))) {
+        pushLine(line);
+    } else {
+        int start = 0;
+        while (start < line.size()) {
+            int end = line.indexOf(QLatin1Char('\n'), start);
+            if (end < 0)
+                end = line.size();
+            int len = end - start;
+            if (len > 0 && line.at(end - 1) == QLatin1Char('\r'))
+                len--;
+            pushLine(line.mid(start, len));
+            start = end + 1;
+        }
+    }
+
+    m_dirty = true;
+    if (!m_refreshTimer.isActive())
+        m_refreshTimer.start();
+}
+
+/**
+ * @brief 写入一行，满时覆盖最旧的行
+ */
+void LogView::pushLine(const QString &line)
+{
+    const int capacity = m_lines.size();
+
+    if (m_count < capacity) {
+        m_lines[(m_first + m_count) % capacity] = line;
+        m_count++;
+    } else {
+        m_lines[m_first] = line;
+        m_first = (m_first + 1) % capacity;
+        m_droppedLines++;
+    }
+
+    // 查看历史时保持画面不动
+    if (m_scrollBack > 0)
+        m_scrollBack = qMin(m_scrollBack + 1, qMax(0, m_count - visibleLineCount()));
+}
+
+void LogView::clear()
+{
+    for (QString &line : m_lines)
+        line.clear();
+    m_first = 0;
+    m_count = 0;
+    m_scrollBack = 0;
+    m_droppedLines = 0;
+    update();
+}
+
+void LogView::setMaximumLines(int lines)
+{
+    m_lines.clear();
+    m_lines.resize(qMax(1, lines));
+    clear();
+}
+
+int LogView::maximumLines() const
+{
+    return m_lines.size();
+}
+
+void LogView::setMaximumRefreshRate(int hz)
+{
+    m_refreshTimer.setInterval(1000 / qMax(1, hz));
+}
+
+const QString &LogView::lineAt(int index) const
+{
+    return m_lines[(m_first + index) % m_lines.size()];
+}
+
+int LogView::visibleLineCount() const
+{
+    // 有丢弃提示时第一行留给提示
+    const int rows = height() / fontMetrics().lineSpacing();
+    return qMax(1, m_droppedLines > 0 ? rows - 1 : rows);
+}
+
+/**
+ * @brief 只绘制可见的行
+ */
+void LogView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+    painter.setPen(palette().color(QPalette::Text));
+
+    const QFontMetrics fm = fontMetrics();
+    const int lineHeight = fm.lineSpacing();
+    const int visible = visibleLineCount();
+
+    // 最底部可见行的索引
+    int last = m_count - 1 - m_scrollBack;
+    int first = qMax(0, last - visible + 1);
+
+    const bool showHint = m_droppedLines > 0;
+    int y = fm.ascent() + 2 + (showHint ? lineHeight : 0);
+    for (int i = first; i <= last; ++i) {
+        painter.drawText(4, y, lineAt(i));
+        y += lineHeight;
+    }
+
+    // 顶部单独一行，右对齐提示丢弃的行数
+    if (showHint) {
+        const QString hint = QString("已丢弃 %1 行").arg(m_droppedLines);
+        painter.setPen(Qt::gray);
+        painter.drawText(rect().adjusted(0, 2, -6, 0), Qt::AlignRight | Qt::AlignTop, hint);
+    }
+}
+
+/**
+ * @brief 滚轮查看历史，回到底部后重新跟随最新行
+ */
+void LogView::wheelEvent(QWheelEvent *event)
+{
+    const int steps = event->angleDelta().y() / 120 * 3;
+    const int maxScroll = qMax(0, m_count - visibleLineCount());
+
+    m_scrollBack = qBound(0, m_scrollBack + steps, maxScroll);
+    update();
+    event->accept();
+}
@@ -0,0 +1,69 @@
+#ifndef LOGVIEW_H
+#define LOGVIEW_H
+
+#include <QWidget>
+#include <QVector>
+#include <QString>
+#include <QTimer>
+
+/**
+ * @brief 轻量日志显示控件
+ *
+ * 用于替代 QTextBrowser 显示高频串口接收日志：
+ *  1. 行数据保存在固定容量的环形缓冲区中，超出容量时丢弃最旧的行并计数。
+ *  2. appendLine() 只记录数据，重绘被合并为最多 30 Hz 一次。
+ *  3. 只绘制可见的行，不做富文本排版，文档大小不会随运行时间增长。
+ *  4. 默认自动滚动到底部，鼠标滚轮可查看历史。
+ */
+class LogView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit LogView(QWidget *parent = nullptr);
+    ~LogView();
+
+    /**
+     * @brief 追加日志，内容中含换行时按行拆分（去掉行尾 '\r'，末尾的换行不产生空行）
+     */
+    void appendLine(const QString &line);
+
+    /**
+     * @brief 清空日志和丢弃计数
+     */
+    void clear();
+
+    /**
+     * @brief 设置最多保留的行数（会清空现有内容）
+     */
+    void setMaximumLines(int lines);
+    int maximumLines() const;
+
+    /**
+     * @brief 设置最大刷新频率（Hz）
+     */
+    void setMaximumRefreshRate(int hz);
+
+    int lineCount() const { return m_count; }              ///< 当前保留的行数
+    quint64 droppedLines() const { return m_droppedLines; } ///< 因超出容量被丢弃的行数
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+
+private:
+    void pushLine(const QString &line);       ///< 向环形缓冲区写入一行
+    const QString &lineAt(int index) const;   ///< index: 0 为最旧的一行
+    int visibleLineCount() const;             ///< 可显示的日志行数（不含丢弃提示行）
+
+    QVector<QString> m_lines;   ///< 环形缓冲区
+    int m_first;                ///< 最旧一行在缓冲区中的位置
+    int m_count;                ///< 当前行数
+    int m_scrollBack;           ///< 向上滚动的行数，0 表示跟随最新
+    quint64 m_droppedLines;     ///< 被丢弃的行数
+
+    QTimer m_refreshTimer;      ///< 重绘合并定时器
+    bool m_dirty;               ///< 是否有未显示的新内容
+};
+
+#endif // LOGVIEW_H